@@ -225,19 +225,89 @@ config_string(
     DEFAULT 256
     UNQUOTE
 )
+config_option(
+    KernelUntypedRetypeBatch UNTYPED_RETYPE_BATCH
+    "Add a RetypeBatch() invocation on untyped caps that creates objects of several types,\
+    each into its own destination window of one CNode, in a single invocation. Each\
+    descriptor is checked exactly as Retype() would check it, and nothing is created unless\
+    all of them are valid and the objects fit in the untyped together. The total number of\
+    objects is bounded by KernelRetypeFanOutLimit, as for a single Retype()."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
 config_string(
     KernelMaxNumWorkUnitsPerPreemption MAX_NUM_WORK_UNITS_PER_PREEMPTION
     "Maximum number of work units (delete/revoke iterations) until the kernel checks for\
-    pending interrupts (and preempts the currently running syscall if interrupts are pending)."
+    pending interrupts (and preempts the currently running syscall if interrupts are pending).\
+    Not used with KernelPreemptionBudget."
     DEFAULT 100
     UNQUOTE
 )
+config_option(
+    KernelPreemptionBudget PREEMPTION_BUDGET
+    "Check for pending interrupts in long-running operations (revoke, delete and untyped \
+    reset) once KernelPreemptionBudgetTicks ticks of a free-running counter have passed \
+    since the invocation started or since the last check, instead of after a fixed \
+    number of work units. The counter is the TSC on x86, the cycle counter on RISC-V \
+    and the generic timer counter on AArch64."
+    DEFAULT OFF
+    DEPENDS "KernelArchX86 OR KernelArchRiscV OR KernelSel4ArchAarch64;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+config_string(
+    KernelPreemptionBudgetTicks PREEMPTION_BUDGET_TICKS
+    "Ticks of the preemption counter after which long-running operations check for \
+    pending interrupts when KernelPreemptionBudget is set."
+    DEFAULT 10000
+    UNQUOTE
+    DEPENDS "KernelPreemptionBudget" UNDEF_DISABLED
+)
 config_string(
     KernelResetChunkBits RESET_CHUNK_BITS
     "Maximum size in bits of chunks of memory to zero before checking a preemption point."
     DEFAULT 8
     UNQUOTE
 )
+config_option(
+    KernelClearMemoryStreaming CLEAR_MEMORY_STREAMING
+    "Zero untyped memory that is being reset with instructions that avoid reading it into\
+    the cache, instead of with ordinary stores. On x86 this uses non-temporal movnti stores,\
+    or rep stosb on CPUs that have enhanced rep movsb/stosb but not SSE2. On AArch64 this\
+    uses DC ZVA when DCZID_EL0 permits it. On RISC-V this uses cbo.zero and requires\
+    KernelRiscvExtZicboz. The method is chosen at boot on x86 and AArch64, and falls back to\
+    ordinary stores when none is available."
+    DEFAULT OFF
+    DEPENDS "KernelArchX86 OR KernelSel4ArchAarch64 OR KernelRiscvExtZicboz;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+config_option(
+    KernelUntypedBackgroundReset UNTYPED_BACKGROUND_RESET
+    "Add a BackgroundReset() invocation on untyped caps that queues an untyped without\
+    children to be reset while a core is idle. Whenever a kernel entry is about to return to\
+    the idle thread, the kernel zeroes queued untypeds chunk by chunk until an interrupt is\
+    pending or KernelUntypedBackgroundResetChunks chunks have been zeroed. A later Retype()\
+    of a fully reset untyped does not need to zero anything. Kernel entries that do not\
+    take the kernel lock (see KernelSMPCoreLocalEntries) do no background work."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+config_string(
+    KernelUntypedBackgroundResetSlots UNTYPED_BACKGROUND_RESET_SLOTS
+    "Maximum number of untypeds that can be queued for background reset at a time."
+    DEFAULT 8
+    UNQUOTE
+    DEPENDS "KernelUntypedBackgroundReset" UNDEF_DISABLED
+)
+config_string(
+    KernelUntypedBackgroundResetChunks UNTYPED_BACKGROUND_RESET_CHUNKS
+    "Maximum number of chunks of 2^KernelResetChunkBits bytes zeroed in the background\
+    each time a kernel entry returns to the idle thread."
+    DEFAULT 256
+    UNQUOTE
+    DEPENDS "KernelUntypedBackgroundReset" UNDEF_DISABLED
+)
 config_string(
     KernelMaxNumBootinfoUntypedCaps MAX_NUM_BOOTINFO_UNTYPED_CAPS
     "Max number of bootinfo untyped caps"
@@ -245,7 +315,75 @@ config_string(
     UNQUOTE
 )
 config_option(KernelFastpath FASTPATH "Enable IPC fastpath" DEFAULT ON)
+config_option(
+    KernelFastpathSend FASTPATH_SEND
+    "Enable an additional IPC fastpath for Send and NBSend on an endpoint that has a \
+    thread waiting to receive. The message is transferred directly and either the \
+    receiver is switched to or, if it does not outrank the sender, it is queued and \
+    the sender continues. All other cases fall back to the slowpath."
+    DEFAULT OFF
+    DEPENDS "KernelFastpath;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+config_option(
+    KernelFastpathSignal FASTPATH_SIGNAL
+    "Extend the Send fastpath to seL4_Signal. Signalling an idle or active notification, \
+    and waking a thread waiting on the notification or a bound thread blocked on an \
+    endpoint, is handled without the slowpath. Waking threads running a VM, on another \
+    core, or that need scheduling context changes still use the slowpath."
+    DEFAULT OFF
+    DEPENDS "KernelFastpathSend"
+    DEFAULT_DISABLED OFF
+)
+config_option(
+    KernelFastCopyMRs FAST_COPY_MRS
+    "Copy message words between IPC buffers with an architecture specific routine \
+    instead of a word by word loop. This uses rep movsq for copies of 32 words or more \
+    on x86_64, ldp/stp pairs on aarch64 and an unrolled loop on RISC-V."
+    DEFAULT OFF
+    DEPENDS
+        "KernelSel4ArchX86_64 OR KernelSel4ArchAarch64 OR KernelArchRiscV;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+config_option(
+    KernelFastpathLongMessages FASTPATH_LONG_MESSAGES
+    "Allow the IPC fastpaths to transfer messages longer than the message registers, up to \
+    a cache line of message words. Words beyond the message registers are copied between the \
+    IPC buffers of the two threads. Longer messages, and threads without an IPC buffer, \
+    use the slowpath."
+    DEFAULT OFF
+    DEPENDS "KernelFastpath;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+config_option(
+    KernelFastpathWait FASTPATH_WAIT
+    "Enable an additional fastpath for Recv and NBRecv (and on MCS, Wait and NBWait) on a \
+    notification. If the notification is active its badge is returned and the notification \
+    reset, and polling an inactive notification returns a zero badge, without entering the \
+    scheduler. Blocking, and receiving on endpoints, use the slowpath."
+    DEFAULT OFF
+    DEPENDS "KernelFastpath;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
 
+config_option(
+    KernelBatchedIPC BATCHED_IPC
+    "Add the seL4_BatchSend system call, which performs a list of non-blocking sends \
+    and signals described in the IPC buffer in a single kernel entry, stopping at the \
+    first one that would block."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+config_option(
+    KernelIPCPageGrant IPC_PAGE_GRANT
+    "Allow a receiver to nominate a receive window with seL4_TCB_SetReceiveWindow. \
+    A small frame capability transferred to that receiver by IPC is then also mapped \
+    at the window in the receiver's address space, so no copy is needed."
+    DEFAULT OFF
+    DEPENDS "KernelArchX86;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
 config_string(
     KernelNumDomains NUM_DOMAINS "The number of scheduler domains in the system"
     DEFAULT 1
@@ -269,6 +407,17 @@ config_string(
     UNQUOTE
 )
 
+config_option(
+    KernelPackedReadyQueues PACKED_READY_QUEUES
+    "Keep each domain's scheduler bitmap and ready queues together, starting on a cache \
+    line of their own, with the queues in descending priority order. The bitmap words \
+    and the heads of the highest priority queues then share a cache line, so choosing \
+    the next thread touches fewer lines."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
 config_string(
     KernelMaxNumNodes MAX_NUM_NODES "Max number of CPU cores to boot"
     DEFAULT 1
@@ -276,6 +425,97 @@ config_string(
     UNQUOTE
 )
 
+config_option(
+    KernelFastpathCrossCore FASTPATH_CROSS_CORE
+    "Allow the IPC fastpaths to wake a receiver, or the caller a reply is sent to, that \
+    has affinity to another core. The message is transferred directly and the woken \
+    thread is queued on its own core, which is sent a single reschedule IPI, if one is \
+    needed, when this core leaves the kernel. Without this option such IPC always takes \
+    the slowpath."
+    DEFAULT OFF
+    DEPENDS "KernelFastpath;${KernelMaxNumNodes} GREATER 1;NOT KernelIsMCS;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_choice(
+    KernelSMPLock
+    SMP_LOCK
+    "Implementation of the big kernel lock on SMP configurations. \
+    clh -> CLH queue lock. Each waiter spins on its predecessor's queue node. \
+    mcs_queue -> Mellor-Crummey/Scott queue lock, unrelated to KernelIsMCS. Each waiter \
+    spins on its own queue node, so a hand-off only writes to the next waiter's cache line. \
+    ticket -> Ticket lock. Cheapest to acquire, but all waiters spin on one cache line. \
+    cohort -> Cluster-aware cohort lock. The lock is preferably handed to a waiter in the \
+    same cluster of KernelSMPLockClusterSize cores, reducing cross-cluster hand-offs."
+    "clh;KernelSMPLockCLH;SMP_LOCK_CLH"
+    "mcs_queue;KernelSMPLockMCSQueue;SMP_LOCK_MCS_QUEUE;NOT KernelVerificationBuild"
+    "ticket;KernelSMPLockTicket;SMP_LOCK_TICKET;NOT KernelVerificationBuild"
+    "cohort;KernelSMPLockCohort;SMP_LOCK_COHORT;NOT KernelVerificationBuild"
+)
+
+config_string(
+    KernelSMPLockClusterSize SMP_LOCK_CLUSTER_SIZE
+    "Number of cores per cluster for the cohort kernel lock. Cores with consecutive \
+    indices are grouped into clusters of this size."
+    DEFAULT 4
+    DEPENDS "KernelSMPLockCohort"
+    UNQUOTE
+)
+
+config_option(
+    KernelSMPBatchedRemoteCalls SMP_BATCHED_REMOTE_CALLS
+    "Queue remote calls that only need to be complete by the time the kernel is left, \
+    which are the TLB and paging structure cache invalidations, and send the calls \
+    queued for each core with a single IPI and a single barrier before the big kernel \
+    lock is released. Repeated calls to the same core are only sent once. Without this \
+    option each remote call is a synchronous IPI round trip."
+    DEFAULT OFF
+    DEPENDS "${KernelMaxNumNodes} GREATER 1;NOT KernelArchRiscV;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelSMPLazyTLBShootdown SMP_LAZY_TLB_SHOOTDOWN
+    "Do not wait for other cores to carry out batched TLB and paging structure cache \
+    invalidations. The cores are sent an IPI and run the invalidations on their next \
+    kernel entry. Retyping untyped memory, mapping a frame or paging structure and \
+    assigning an ASID, which are when memory or ASIDs that were in use can be reused, \
+    wait for all outstanding invalidations to complete. Until a core has caught up, \
+    a thread running on it may still access a mapping that has just been removed. \
+    Only supported on x86."
+    DEFAULT OFF
+    DEPENDS "KernelSMPBatchedRemoteCalls;KernelArchX86;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_option(
+    KernelRevokeBatch REVOKE_BATCH
+    "While revoking a capability, collect the remote TLB invalidations for the frames \
+    that are unmapped and send them once for every KernelRevokeBatchSize deleted \
+    descendants, and before the revoke is preempted or returns, instead of once for \
+    every frame. Each core is sent a single-page invalidation if only one frame was \
+    unmapped in the batch, an invalidation of the address space if all of them were in \
+    the same one, and a full invalidation otherwise. The revoke checks for preemption \
+    once per batch instead of after every deleted descendant."
+    DEFAULT OFF
+    DEPENDS "KernelArchX86;${KernelMaxNumNodes} GREATER 1;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
+config_string(
+    KernelRevokeBatchSize REVOKE_BATCH_SIZE
+    "Number of descendants deleted by a revoke before the remote TLB invalidations \
+    collected for them are sent and the revoke checks for preemption, when \
+    KernelRevokeBatch is set. Must be at least 1. Larger batches send fewer IPIs \
+    but delay preemption for longer."
+    DEFAULT 64
+    UNQUOTE
+    DEPENDS "KernelRevokeBatch" UNDEF_DISABLED
+)
+if(KernelRevokeBatch AND (KernelRevokeBatchSize LESS 1))
+    message(FATAL_ERROR "KernelRevokeBatchSize must be at least 1, got ${KernelRevokeBatchSize}.")
+endif()
+
 config_string(
     KernelStackBits KERNEL_STACK_BITS
     "This describes the log2 size of the kernel stack. Great care should be taken as\
@@ -369,6 +609,96 @@ config_string(
     DEPENDS "NOT KernelVerificationBuild;KernelBenchmarksTracepoints" DEFAULT_DISABLED 0
     UNQUOTE
 )
+config_option(
+    KernelBenchmarkTrackRing BENCHMARK_TRACK_RING
+    "Instead of filling the log buffer once, record kernel entries in one ring per \
+    core in the log buffer, overwriting the oldest entries. Each core only writes \
+    to its own ring, so a user-level tracer that maps the log buffer can read the \
+    rings continuously. The layout is described by benchmark_track_ring_t."
+    DEFAULT OFF
+    DEPENDS "NOT KernelVerificationBuild;KernelBenchmarksTrackKernelEntries"
+    DEFAULT_DISABLED OFF
+)
+config_string(
+    KernelBenchmarkTrackRingBits BENCHMARK_TRACK_RING_BITS
+    "Log2 of the number of kernel entries each core's ring holds. All rings must \
+    fit in the log buffer."
+    DEFAULT 12
+    DEPENDS "KernelBenchmarkTrackRing" DEFAULT_DISABLED 0
+    UNQUOTE
+)
+config_string(
+    KernelBenchmarkTrackHistograms BENCHMARK_TRACK_HISTOGRAMS
+    "Number of kernel entry latency histograms each core keeps when tracking kernel \
+    entries, one for each combination of entry path, syscall, cap type and invocation \
+    label seen. The histograms are read with seL4_BenchmarkGetEntryHistogram, which \
+    merges the counts of all cores, and do not need a log buffer. 0 disables them."
+    DEFAULT 0
+    DEPENDS "NOT KernelVerificationBuild;KernelBenchmarksTrackKernelEntries" DEFAULT_DISABLED 0
+    UNQUOTE
+)
+
+config_option(
+    KernelBenchmarkUtilisationPMU BENCHMARK_UTILISATION_PMU
+    "Count hardware events per thread when tracking utilisation: instructions retired, \
+    level 1 data and level 2 cache misses, branch mispredictions and data TLB misses. \
+    The counts are returned by seL4_BenchmarkGetThreadUtilisation. The kernel \
+    programs the performance counters it uses, so user level must not reprogram them."
+    DEFAULT OFF
+    DEPENDS
+        "KernelBenchmarksTrackUtilisation;KernelArchX86 OR KernelArchArmV7a OR KernelArchArmV8a;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+config_option(
+    KernelBenchmarkSampling BENCHMARK_SAMPLING
+    "Sample the running thread from the performance monitor overflow interrupt when \
+    tracking utilisation. Each sample holds the thread, its user-level program counter \
+    and the return addresses found by walking its frame pointers, and is written to a \
+    ring per core in the log buffer between seL4_BenchmarkResetLog and \
+    seL4_BenchmarkFinalizeLog. The layout is described by benchmark_sample_ring_t. \
+    The kernel uses the last event counter of the PMU for this."
+    DEFAULT OFF
+    DEPENDS "KernelBenchmarksTrackUtilisation;KernelArchArmV7a OR KernelArchArmV8a;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+config_string(
+    KernelBenchmarkSamplingPeriod BENCHMARK_SAMPLING_PERIOD
+    "Number of cycles between two samples. Must be less than 2^32."
+    DEFAULT 1000000
+    DEPENDS "KernelBenchmarkSampling" DEFAULT_DISABLED 0
+    UNQUOTE
+)
+config_string(
+    KernelBenchmarkSamplingRingBits BENCHMARK_SAMPLING_RING_BITS
+    "Log2 of the number of samples each core's ring holds. All rings must fit in \
+    the log buffer."
+    DEFAULT 10
+    DEPENDS "KernelBenchmarkSampling" DEFAULT_DISABLED 0
+    UNQUOTE
+)
+config_string(
+    KernelBenchmarkSamplingStackDepth BENCHMARK_SAMPLING_STACK_DEPTH
+    "Maximum number of return addresses recorded in a sample."
+    DEFAULT 13
+    DEPENDS "KernelBenchmarkSampling" DEFAULT_DISABLED 0
+    UNQUOTE
+)
+
+config_option(
+    KernelSMPCoreLocalEntries SMP_CORE_LOCAL_ENTRIES
+    "Run kernel entries that only touch state owned by the current core, which are \
+    timer ticks and seL4_Yield, without taking the big kernel lock. Such an entry \
+    only marks its core as busy; a core taking the big kernel lock waits for the \
+    marked cores to leave the kernel. Call and ReplyRecv fastpaths between two threads \
+    with affinity to the current core also run without the big kernel lock, holding \
+    one of a small set of locks shared by endpoints instead. Other entries are unaffected. \
+    Requires a single scheduler domain, as ticks and rescheduling advance the domain \
+    schedule, which is shared by all cores."
+    DEFAULT OFF
+    DEPENDS
+        "${KernelMaxNumNodes} GREATER 1;${KernelNumDomains} EQUAL 1;NOT KernelIsMCS;NOT KernelDebugBuild;NOT KernelBenchmarksTrackKernelEntries;NOT KernelBenchmarksTrackUtilisation;NOT KernelArmHypervisorSupport;NOT KernelSel4ArchAarch32;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
 
 config_option(
     KernelIRQReporting IRQ_REPORTING
@@ -459,6 +789,17 @@ config_string(
     DEPENDS "KernelIsMCS" UNDEF_DISABLED
 )
 
+config_option(
+    KernelReleaseQueueHeap RELEASE_QUEUE_HEAP
+    "Keep each core's release queue as a pairing heap ordered by release time rather than \
+    a sorted list. Inserting a thread into a sorted list is linear in the length of the \
+    queue; the heap makes insertion constant time and removal logarithmic (amortised), \
+    which matters with many periodic threads per core."
+    DEFAULT OFF
+    DEPENDS "KernelIsMCS;NOT KernelVerificationBuild"
+    DEFAULT_DISABLED OFF
+)
+
 config_option(
     KernelClz32 CLZ_32 "Define a __clzsi2 function to count leading zeros for uint32_t arguments. \
                         Only needed on platforms which lack a builtin instruction."
@@ -35,6 +35,37 @@ exception_t handleUnknownSyscall(word_t w);
 exception_t handleUserLevelFault(word_t w_a, word_t w_b);
 exception_t handleVMFaultEvent(vm_fault_type_t vm_faultType);
 
+/* Syscalls that are started without the big kernel lock when core-local
+ * entries are enabled, see NODE_LOCK_IF_NOT_CORE_LOCAL. They either only
+ * touch this core's state or, like an NBRecv with nothing to receive, only
+ * read shared state. An NBRecv that does find something takes the lock before
+ * going any further. With the Recv fastpath, NBRecv is served there instead. */
+static inline bool_t isCoreLocalSyscall(syscall_t syscall)
+{
+    return syscall == SysYield
+#ifndef CONFIG_FASTPATH_WAIT
+           || syscall == SysNBRecv
+#endif
+#ifdef CONFIG_ENABLE_BENCHMARKS
+           || syscall == (syscall_t)SysBenchmarkNullSyscall
+#endif
+           ;
+}
+
+/* Syscalls whose fastpath is started without the big kernel lock when
+ * core-local entries are enabled. The fastpath only goes on without the lock
+ * if the IPC is between two threads with affinity to this core and it can
+ * take the endpoint's lock, see core_local_try_lock_ep. Otherwise it gives up
+ * before changing anything and handleSyscall takes the big kernel lock. */
+static inline bool_t isCoreLocalFastpathSyscall(syscall_t syscall)
+{
+#ifdef CONFIG_FASTPATH
+    return syscall == SysCall || syscall == SysReplyRecv;
+#else
+    return false;
+#endif
+}
+
 static inline word_t PURE getSyscallArg(word_t i, word_t *ipc_buffer)
 {
     if (i < n_msgRegisters) {
@@ -35,6 +35,15 @@
 #endif
 #define CNTFRQ   "cntfrq_el0"
 
+#ifdef CONFIG_PREEMPTION_BUDGET
+static inline uint64_t readPreemptionCounter(void)
+{
+    uint64_t ticks;
+    MRS(CNT_CT, ticks);
+    return ticks;
+}
+#endif
+
 #ifdef ENABLE_SMP_SUPPORT
 /* Use the first two SGI (Software Generated Interrupt) IDs
  * for seL4 IPI implementation. SGIs are per-core banked.
@@ -375,4 +384,26 @@ static inline word_t ats2e0r(word_t va)
 void arch_clean_invalidate_caches(void);
 void arch_clean_invalidate_L1_caches(word_t type);
 
+#ifdef CONFIG_FAST_COPY_MRS
+/* Copy 'n' words between IPC buffers, two words at a time with ldp/stp.
+ * The kernel is built with -mgeneral-regs-only, so NEON is not used. */
+static inline void copyWords(word_t *dest, const word_t *src, word_t n)
+{
+    word_t a, b;
+
+    for (; n >= 2; n -= 2) {
+        asm volatile(
+            "ldp %0, %1, [%2], #16\n"
+            "stp %0, %1, [%3], #16"
+            : "=&r"(a), "=&r"(b), "+r"(src), "+r"(dest)
+            :
+            : "memory"
+        );
+    }
+    if (n) {
+        *dest = *src;
+    }
+}
+#endif /* CONFIG_FAST_COPY_MRS */
+
 
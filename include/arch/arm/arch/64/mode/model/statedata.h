@@ -28,6 +28,10 @@ extern pude_t armKSGlobalKernelPUD[BIT(PUD_INDEX_BITS)] VISIBLE;
 extern pde_t armKSGlobalKernelPDs[BIT(PUD_INDEX_BITS)][BIT(PD_INDEX_BITS)] VISIBLE;
 extern pte_t armKSGlobalKernelPT[BIT(PT_INDEX_BITS)] VISIBLE;
 
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+extern word_t armKSdczvaBlockBits;
+#endif
+
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
 
 extern asid_t armKSHWASIDTable[BIT(hwASIDBits)] VISIBLE;
@@ -17,6 +17,10 @@
 #define PMCR_ENABLE 0
 #define PMCR_ECNT_RESET 1
 #define PMCR_CCNT_RESET 2
+#define PMCR_NUM_COUNTERS 11
+
+/* count events at EL2 as well */
+#define PMXEVTYPER_NSH 27
 
 #if defined(CONFIG_BENCHMARK_TRACK_UTILISATION) && defined(KERNEL_PMU_IRQ)
 #define CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT 1
@@ -31,9 +35,37 @@ static inline timestamp_t timestamp(void)
     return ccnt;
 }
 
+#ifdef CONFIG_BENCHMARK_SAMPLING
+#include <benchmark/benchmark_sampling.h>
+
+/* The event counter that counts cycles until the next sample */
+extern word_t benchmark_sample_counter;
+
+static inline void benchmark_arch_sampling_rearm(void)
+{
+    SYSTEM_WRITE_WORD(PMSELR, benchmark_sample_counter);
+    isb();
+    /* overflow after another sampling period */
+    SYSTEM_WRITE_WORD(PMXEVCNTR, UINT32_MAX - CONFIG_BENCHMARK_SAMPLING_PERIOD + 1);
+    SYSTEM_WRITE_WORD(PMOVSR, BIT(benchmark_sample_counter));
+}
+#endif /* CONFIG_BENCHMARK_SAMPLING */
+
 #ifdef CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT
 static inline void handleOverflowIRQ(void)
 {
+#ifdef CONFIG_BENCHMARK_SAMPLING
+    word_t overflowed;
+
+    SYSTEM_READ_WORD(PMOVSR, overflowed);
+    if (overflowed & BIT(benchmark_sample_counter)) {
+        benchmark_sampling_record();
+        benchmark_arch_sampling_rearm();
+    }
+    if (!(overflowed & BIT(CCNT_INDEX))) {
+        return;
+    }
+#endif /* CONFIG_BENCHMARK_SAMPLING */
     if (likely(NODE_STATE(benchmark_log_utilisation_enabled))) {
         NODE_STATE(ksCurThread)->benchmark.utilisation += UINT32_MAX - NODE_STATE(ksCurThread)->benchmark.schedule_start_time;
         NODE_STATE(ksCurThread)->benchmark.schedule_start_time = 0;
@@ -49,5 +81,28 @@ static inline void benchmark_arch_utilisation_reset(void)
     NODE_STATE(ccnt_num_overflows) = 0;
 #endif /* CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT */
 }
+
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+#include <sel4/benchmark_utilisation_types.h>
+
+/* Event counters are 32 bits wide */
+#define BENCHMARK_ARCH_PMU_COUNTER_MASK 0xffffffffull
+
+/* Event counter i counts event i; there may be fewer counters than events */
+extern word_t benchmark_pmu_num_counters;
+
+static inline uint64_t benchmark_arch_pmu_read(word_t event)
+{
+    word_t count;
+
+    if (event >= benchmark_pmu_num_counters) {
+        return 0;
+    }
+    SYSTEM_WRITE_WORD(PMSELR, event);
+    isb();
+    SYSTEM_READ_WORD(PMXEVCNTR, count);
+    return count;
+}
+#endif /* CONFIG_BENCHMARK_UTILISATION_PMU */
 #endif /* CONFIG_ENABLE_BENCHMARKS */
 
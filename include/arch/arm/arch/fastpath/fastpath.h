@@ -26,4 +26,16 @@ void fastpath_reply_recv(word_t cptr, word_t r_msgInfo)
 #endif
 NORETURN;
 
+#ifdef CONFIG_FASTPATH_SEND
+static inline
+void fastpath_send(word_t cptr, word_t r_msgInfo, syscall_t syscall)
+NORETURN;
+#endif
+
+#ifdef CONFIG_FASTPATH_WAIT
+static inline
+void fastpath_wait(word_t cptr, word_t r_msgInfo, syscall_t syscall)
+NORETURN;
+#endif
+
 
@@ -35,6 +35,16 @@ void c_handle_fastpath_reply_recv(word_t cptr, word_t msgInfo, word_t reply)
 void c_handle_fastpath_reply_recv(word_t cptr, word_t msgInfo)
 #endif
 VISIBLE SECTION(".vectors.text");
+
+#ifdef CONFIG_FASTPATH_SEND
+void c_handle_fastpath_send(word_t cptr, word_t msgInfo, syscall_t syscall)
+VISIBLE SECTION(".vectors.text");
+#endif
+
+#ifdef CONFIG_FASTPATH_WAIT
+void c_handle_fastpath_wait(word_t cptr, word_t msgInfo, syscall_t syscall)
+VISIBLE SECTION(".vectors.text");
+#endif
 #endif
 
 void c_handle_interrupt(void)
@@ -50,3 +50,9 @@ exception_t decodeARMMMUInvocation(word_t invLabel, word_t length, cptr_t cptr,
 void Arch_userStackTrace(tcb_t *tptr);
 #endif
 
+#ifdef CONFIG_BENCHMARK_SAMPLING
+/* Follow the thread's frame pointers, storing up to max return addresses in
+ * callers. Returns the number of return addresses stored. */
+word_t Arch_userCallStack(tcb_t *tptr, word_t *callers, word_t max);
+#endif
+
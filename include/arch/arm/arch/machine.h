@@ -61,6 +61,18 @@ static inline void clearMemoryRAM(word_t *ptr, word_t bits)
                         addrFromPPtr(ptr));
 }
 
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+/* Like clearMemory, but zeroes whole blocks with DC ZVA, without reading them,
+ * if the CPU permits it. */
+void clearMemoryStreaming(word_t *ptr, word_t bits);
+void arm_init_clear_memory(void);
+
+static inline void clearMemoryStreamingFence(void)
+{
+    /* clearMemoryStreaming already ends with a dsb */
+}
+#endif
+
 #ifdef ENABLE_SMP_SUPPORT
 static inline void arch_pause(void)
 {
@@ -24,17 +24,17 @@ static inline void doRemoteswitchFpuOwner(user_fpu_state_t *new_owner, word_t cp
 
 static inline void doRemoteInvalidateTranslationSingle(vptr_t vptr, word_t mask)
 {
-    doRemoteMaskOp1Arg(IpiRemoteCall_InvalidateTranslationSingle, vptr, mask);
+    doRemoteMaskOpDeferred(IpiRemoteCall_InvalidateTranslationSingle, vptr, 0, 0, mask);
 }
 
 static inline void doRemoteInvalidateTranslationASID(asid_t asid, word_t mask)
 {
-    doRemoteMaskOp1Arg(IpiRemoteCall_InvalidateTranslationASID, asid, mask);
+    doRemoteMaskOpDeferred(IpiRemoteCall_InvalidateTranslationASID, asid, 0, 0, mask);
 }
 
 static inline void doRemoteInvalidateTranslationAll(word_t mask)
 {
-    doRemoteMaskOp0Arg(IpiRemoteCall_InvalidateTranslationAll, mask);
+    doRemoteMaskOpDeferred(IpiRemoteCall_InvalidateTranslationAll, 0, 0, 0, mask);
 }
 
 static inline void doRemoteMaskPrivateInterrupt(word_t cpu, word_t disable, word_t irq)
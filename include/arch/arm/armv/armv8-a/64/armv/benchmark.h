@@ -15,6 +15,9 @@
 #define PMINTENSET "PMINTENSET_EL1"
 #define PMOVSR "PMOVSCLR_EL0"
 #define CCNT_INDEX 31
+#define PMSELR "PMSELR_EL0"
+#define PMXEVTYPER "PMXEVTYPER_EL0"
+#define PMXEVCNTR "PMXEVCNTR_EL0"
 
 static inline void armv_enableOverflowIRQ(void)
 {
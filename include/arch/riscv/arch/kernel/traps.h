@@ -28,6 +28,16 @@ VISIBLE NORETURN;
 void c_handle_fastpath_call(word_t cptr, word_t msgInfo)
 VISIBLE NORETURN;
 
+#ifdef CONFIG_FASTPATH_SEND
+void c_handle_fastpath_send(word_t cptr, word_t msgInfo, syscall_t syscall)
+VISIBLE NORETURN;
+#endif
+
+#ifdef CONFIG_FASTPATH_WAIT
+void c_handle_fastpath_wait(word_t cptr, word_t msgInfo, syscall_t syscall)
+VISIBLE NORETURN;
+#endif
+
 void c_handle_syscall(word_t cptr, word_t msgInfo, syscall_t syscall)
 VISIBLE NORETURN;
 
@@ -115,6 +115,36 @@ static inline void clearMemory(void *ptr, unsigned int bits)
     memzero(ptr, BIT(bits));
 }
 
+#ifdef CONFIG_PREEMPTION_BUDGET
+static inline uint64_t readPreemptionCounter(void)
+{
+    /* rdtime is emulated by the SBI on some platforms, rdcycle never is */
+    return riscv_read_cycle();
+}
+#endif
+
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+/* Like clearMemory, but zeroes whole cache blocks without reading them. */
+static inline void clearMemoryStreaming(void *ptr, word_t bits)
+{
+    word_t p;
+
+    if (bits < CONFIG_RISCV_CBOZ_BLOCK_BITS) {
+        memzero(ptr, BIT(bits));
+        return;
+    }
+    for (p = (word_t)ptr; p < (word_t)ptr + BIT(bits); p += BIT(CONFIG_RISCV_CBOZ_BLOCK_BITS)) {
+        /* cbo.zero (p) */
+        asm volatile(".insn i 0x0f, 2, x0, %0, 4" :: "r"(p) : "memory");
+    }
+}
+
+static inline void clearMemoryStreamingFence(void)
+{
+    /* cbo.zero is ordered like an ordinary store */
+}
+#endif
+
 static inline void write_satp(word_t value)
 {
     asm volatile("csrw satp, %0" :: "rK"(value));
@@ -255,6 +285,24 @@ static inline void Arch_setTLSRegister(word_t tls_base)
     setRegister(NODE_STATE(ksCurThread), TLS_BASE, tls_base);
 }
 
+#ifdef CONFIG_FAST_COPY_MRS
+/* Copy 'n' words between IPC buffers, unrolled four times so that the
+ * loads are issued ahead of the stores that depend on them. */
+static inline void copyWords(word_t *dest, const word_t *src, word_t n)
+{
+    for (; n >= 4; n -= 4, dest += 4, src += 4) {
+        word_t w0 = src[0], w1 = src[1], w2 = src[2], w3 = src[3];
+        dest[0] = w0;
+        dest[1] = w1;
+        dest[2] = w2;
+        dest[3] = w3;
+    }
+    for (; n; n--) {
+        *dest++ = *src++;
+    }
+}
+#endif /* CONFIG_FAST_COPY_MRS */
+
 #endif // __ASSEMBLER__
 
 
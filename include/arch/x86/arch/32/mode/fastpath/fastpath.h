@@ -94,7 +94,7 @@ static inline void NORETURN FORCE_INLINE fastpath_restore(word_t badge, word_t m
 {
     c_exit_hook();
 
-    NODE_UNLOCK;
+    NODE_UNLOCK_FASTPATH;
     lazyFPURestore(cur_thread);
 
 #ifdef CONFIG_HARDWARE_DEBUG_API
@@ -72,6 +72,12 @@ static inline void invalidateLocalTranslationSingleASID(vptr_t vptr, asid_t asid
     invalidateLocalTLBEntry(vptr);
 }
 
+static inline void invalidateLocalTranslationASID(asid_t asid)
+{
+    /* no asid support in 32-bit, just invalidate TLB */
+    invalidateLocalTLB();
+}
+
 static inline void invalidateLocalTranslationAll(void)
 {
     invalidateLocalTLB();
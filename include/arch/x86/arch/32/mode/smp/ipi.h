@@ -21,17 +21,17 @@ typedef enum {
 
 static void inline doRemoteInvalidateTLBEntry(vptr_t vptr, word_t mask)
 {
-    doRemoteMaskOp1Arg((IpiRemoteCall_t)IpiRemoteCall_InvalidateTLBEntry, vptr, mask);
+    doRemoteMaskOpDeferred((IpiRemoteCall_t)IpiRemoteCall_InvalidateTLBEntry, vptr, 0, 0, mask);
 }
 
 static void inline doRemoteInvalidatePageStructureCache(word_t mask)
 {
-    doRemoteMaskOp0Arg((IpiRemoteCall_t)IpiRemoteCall_InvalidatePageStructureCache, mask);
+    doRemoteMaskOpDeferred((IpiRemoteCall_t)IpiRemoteCall_InvalidatePageStructureCache, 0, 0, 0, mask);
 }
 
 static void inline doRemoteInvalidateTLB(word_t mask)
 {
-    doRemoteMaskOp0Arg((IpiRemoteCall_t)IpiRemoteCall_InvalidateTLB, mask);
+    doRemoteMaskOpDeferred((IpiRemoteCall_t)IpiRemoteCall_InvalidateTLB, 0, 0, 0, mask);
 }
 
 void Mode_handleRemoteCall(IpiModeRemoteCall_t call, word_t arg0, word_t arg1, word_t arg2);
@@ -129,7 +129,7 @@ static inline void NORETURN FORCE_INLINE fastpath_restore(word_t badge, word_t m
          */
         restore_user_context();
     }
-    NODE_UNLOCK;
+    NODE_UNLOCK_FASTPATH;
     c_exit_hook();
     lazyFPURestore(cur_thread);
 
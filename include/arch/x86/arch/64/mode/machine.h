@@ -182,6 +182,11 @@ static inline void invalidateLocalTranslationSingleASID(vptr_t vptr, asid_t asid
     invalidateLocalPCID(INVPCID_TYPE_ADDR, (void *)vptr, asid);
 }
 
+static inline void invalidateLocalTranslationASID(asid_t asid)
+{
+    invalidateLocalPCID(INVPCID_TYPE_SINGLE, (void *)0, asid);
+}
+
 static inline void invalidateLocalTranslationAll(void)
 {
     invalidateLocalPCID(INVPCID_TYPE_ALL_GLOBAL, (void *)0, 0);
@@ -334,3 +339,30 @@ static inline void x86_set_tls_segment_base(word_t tls_base)
     x86_write_fs_base(tls_base, SMP_TERNARY(getCurrentCPUIndex(), 0));
 }
 
+#ifdef CONFIG_FAST_COPY_MRS
+/* Below this many words the startup cost of 'rep movsq' is higher than that
+ * of a plain loop. */
+#define COPY_WORDS_REP_MIN 32
+
+/* Copy 'n' words between IPC buffers. The kernel does not use the SSE or
+ * AVX registers, but 'rep movsq' is fast for long copies. The direction
+ * flag is user controlled and so is cleared first. */
+static inline void copyWords(word_t *dest, const word_t *src, word_t n)
+{
+    if (n < COPY_WORDS_REP_MIN) {
+        for (word_t i = 0; i < n; i++) {
+            dest[i] = src[i];
+        }
+        return;
+    }
+
+    asm volatile(
+        "cld\n"
+        "rep movsq"
+        : "+D"(dest), "+S"(src), "+c"(n)
+        :
+        : "memory", "cc"
+    );
+}
+#endif /* CONFIG_FAST_COPY_MRS */
+
@@ -35,5 +35,29 @@ static inline void benchmark_arch_utilisation_reset(void)
 {
 }
 
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+#include <sel4/benchmark_utilisation_types.h>
+
+/* Architectural performance counters are at least 40 bits wide */
+#define BENCHMARK_ARCH_PMU_COUNTER_MASK 0xffffffffffull
+#define BENCHMARK_PMU_NO_COUNTER 0xffffffffu
+
+/* rdpmc index of the counter counting each event */
+extern uint32_t benchmark_pmu_counter[BENCHMARK_PMU_NUM_EVENTS];
+
+void benchmark_arch_pmu_init(void);
+
+static inline uint64_t benchmark_arch_pmu_read(word_t event)
+{
+    uint32_t low, high;
+
+    if (benchmark_pmu_counter[event] == BENCHMARK_PMU_NO_COUNTER) {
+        return 0;
+    }
+    asm volatile("rdpmc" : "=a"(low), "=d"(high) : "c"(benchmark_pmu_counter[event]));
+    return ((uint64_t) high) << 32llu | (uint64_t) low;
+}
+#endif /* CONFIG_BENCHMARK_UTILISATION_PMU */
+
 #endif /* CONFIG_ENABLE_BENCHMARKS */
 
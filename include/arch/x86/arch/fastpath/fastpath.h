@@ -27,3 +27,13 @@ void fastpath_reply_recv(word_t cptr, word_t r_msgInfo, word_t reply)
 void fastpath_reply_recv(word_t cptr, word_t r_msgInfo)
 #endif
 NORETURN;
+
+#ifdef CONFIG_FASTPATH_SEND
+void fastpath_send(word_t cptr, word_t r_msgInfo, syscall_t syscall)
+NORETURN;
+#endif
+
+#ifdef CONFIG_FASTPATH_WAIT
+void fastpath_wait(word_t cptr, word_t r_msgInfo, syscall_t syscall)
+NORETURN;
+#endif
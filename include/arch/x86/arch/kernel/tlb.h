@@ -32,4 +32,14 @@ static inline void invalidateTranslationAll(word_t mask)
     SMP_COND_STATEMENT(doRemoteInvalidateTranslationAll(mask));
 }
 
+/* With lazy TLB shootdowns another core may still translate through entries
+ * that have been removed. Wait for them before a frame, paging structure or
+ * ASID can be installed again, where the stale entries would reach it. */
+static inline void waitForLazyTLBShootdowns(void)
+{
+#ifdef CONFIG_SMP_LAZY_TLB_SHOOTDOWN
+    doRemoteCallBatchWait();
+#endif
+}
+
 
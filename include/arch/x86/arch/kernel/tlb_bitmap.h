@@ -25,13 +25,22 @@ static inline void tlb_bitmap_init(vspace_root_t *root)
 static inline void tlb_bitmap_set(vspace_root_t *root, word_t cpu)
 {
     assert(cpu < TLBBITMAP_ROOT_BITS && cpu <= wordBits);
+#ifdef CONFIG_SMP_CORE_LOCAL_ENTRIES
+    /* cores switching to this vspace in core-local entries may race here */
+    __atomic_fetch_or(&root[TLBBITMAP_ROOT_MAKE_INDEX(cpu)].words[0], TLBBITMAP_ROOT_MAKE_BIT(cpu), __ATOMIC_RELAXED);
+#else
     root[TLBBITMAP_ROOT_MAKE_INDEX(cpu)].words[0] |= TLBBITMAP_ROOT_MAKE_BIT(cpu);
+#endif
 }
 
 static inline void tlb_bitmap_unset(vspace_root_t *root, word_t cpu)
 {
     assert(cpu < TLBBITMAP_ROOT_BITS && cpu <= wordBits);
+#ifdef CONFIG_SMP_CORE_LOCAL_ENTRIES
+    __atomic_fetch_and(&root[TLBBITMAP_ROOT_MAKE_INDEX(cpu)].words[0], ~TLBBITMAP_ROOT_MAKE_BIT(cpu), __ATOMIC_RELAXED);
+#else
     root[TLBBITMAP_ROOT_MAKE_INDEX(cpu)].words[0] &= ~TLBBITMAP_ROOT_MAKE_BIT(cpu);
+#endif
 }
 
 static inline word_t tlb_bitmap_get(vspace_root_t *root)
@@ -90,6 +90,12 @@ void deleteASID(asid_t asid, vspace_root_t *vspace);
 findVSpaceForASID_ret_t findVSpaceForASID(asid_t asid);
 
 void unmapPage(vm_page_size_t page_size, asid_t asid, vptr_t vptr, void *pptr);
+#ifdef CONFIG_REVOKE_BATCH
+/* While a revoke batch is open unmapPage only invalidates the local TLB and
+ * leaves the remote invalidations to Arch_revokeBatchEnd. */
+void Arch_revokeBatchBegin(void);
+void Arch_revokeBatchEnd(void);
+#endif
 /* returns whether the translation was removed and needs to be flushed from the hardware (i.e. tlb) */
 bool_t modeUnmapPage(vm_page_size_t page_size, vspace_root_t *vroot, vptr_t vptr, void *pptr);
 exception_t decodeX86ModeMapPage(word_t invLabel, vm_page_size_t page_size, cte_t *cte, cap_t cap,
@@ -98,6 +104,9 @@ void setVMRoot(tcb_t *tcb);
 bool_t CONST isValidVTableRoot(cap_t cap);
 bool_t CONST isValidNativeRoot(cap_t cap);
 exception_t checkValidIPCBuffer(vptr_t vptr, cap_t cap);
+#ifdef CONFIG_IPC_PAGE_GRANT
+bool_t Arch_mapReceiveWindow(tcb_t *receiver, cte_t *frameSlot, vptr_t window);
+#endif
 vm_rights_t CONST maskVMRights(vm_rights_t vm_rights, seL4_CapRights_t cap_rights_mask);
 void flushTable(vspace_root_t *vspace, word_t vptr, pte_t *pt, asid_t asid);
 
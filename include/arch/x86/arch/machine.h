@@ -193,6 +193,13 @@ static inline uint64_t x86_rdtsc(void)
     return ((uint64_t) hi) << 32llu | (uint64_t) lo;
 }
 
+#ifdef CONFIG_PREEMPTION_BUDGET
+static inline uint64_t readPreemptionCounter(void)
+{
+    return x86_rdtsc();
+}
+#endif
+
 #ifdef ENABLE_SMP_SUPPORT
 static inline void arch_pause(void)
 {
@@ -344,6 +351,26 @@ static inline void clearMemory(void *ptr, unsigned int bits)
     /* no cleaning of caches necessary on IA-32 */
 }
 
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+enum x86_clear_memory_method {
+    x86_clear_memory_stores = 0,
+    x86_clear_memory_rep_stosb,
+    x86_clear_memory_movnti
+};
+
+/* Like clearMemory, but without reading the memory into the cache if the
+ * CPU allows it. The method is chosen by x86_init_clear_memory. The stores
+ * are only ordered before later ones by clearMemoryStreamingFence. */
+void clearMemoryStreaming(void *ptr, word_t bits);
+
+static inline void clearMemoryStreamingFence(void)
+{
+    /* movnti stores are weakly ordered */
+    asm volatile("sfence" ::: "memory");
+}
+BOOT_CODE void x86_init_clear_memory(void);
+#endif
+
 /* Initialises MSRs required to setup sysenter and sysexit */
 void init_sysenter_msrs(void);
 
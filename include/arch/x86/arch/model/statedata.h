@@ -68,6 +68,25 @@ extern x86_arch_global_state_t x86KSGlobalState[CONFIG_MAX_NUM_NODES] ALIGN(L1_C
 
 extern asid_pool_t *x86KSASIDTable[];
 extern uint32_t x86KScacheLineSizeBits;
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+extern uint32_t x86KSclearMemoryMethod;
+#endif
+#ifdef CONFIG_REVOKE_BATCH
+/* Remote TLB invalidations deferred by unmapPage while a revoke batch is open */
+typedef struct x86_revoke_batch {
+    bool_t open;
+    /* number of unmapped pages that other cores may have cached, and the
+     * last one of them */
+    word_t pages;
+    vptr_t vptr;
+    asid_t asid;
+    /* whether all of those pages were in the same address space */
+    bool_t sameASID;
+    /* cores that have to invalidate their TLB when the batch is closed */
+    word_t mask;
+} x86_revoke_batch_t;
+extern x86_revoke_batch_t x86KSrevokeBatch;
+#endif
 extern user_fpu_state_t x86KSnullFpuState ALIGN(MIN_FPU_ALIGNMENT);
 
 #ifdef CONFIG_IOMMU
@@ -18,7 +18,13 @@ typedef enum {
     IpiRemoteCall_InvalidateTranslationSingle,
     IpiRemoteCall_InvalidateTranslationSingleASID,
     IpiRemoteCall_InvalidateTranslationAll,
+#ifdef CONFIG_REVOKE_BATCH
+    IpiRemoteCall_InvalidateTranslationASID,
+#endif
     IpiRemoteCall_switchFpuOwner,
+#ifdef CONFIG_SMP_BATCHED_REMOTE_CALLS
+    IpiRemoteCall_Batch,
+#endif
     IpiNumArchRemoteCall
 } IpiRemoteCall_t;
 
@@ -22,24 +22,31 @@ static inline void doRemoteswitchFpuOwner(user_fpu_state_t *new_owner, word_t cp
 
 static inline void doRemoteInvalidatePageStructureCacheASID(paddr_t root, asid_t asid, word_t mask)
 {
-    doRemoteMaskOp2Arg(IpiRemoteCall_InvalidatePageStructureCacheASID, root, asid, mask);
+    doRemoteMaskOpDeferred(IpiRemoteCall_InvalidatePageStructureCacheASID, root, asid, 0, mask);
 }
 
 static inline void doRemoteInvalidateTranslationSingle(vptr_t vptr, word_t mask)
 {
-    doRemoteMaskOp1Arg(IpiRemoteCall_InvalidateTranslationSingle, vptr, mask);
+    doRemoteMaskOpDeferred(IpiRemoteCall_InvalidateTranslationSingle, vptr, 0, 0, mask);
 }
 
 static inline void doRemoteInvalidateTranslationSingleASID(vptr_t vptr, asid_t asid, word_t mask)
 {
-    doRemoteMaskOp2Arg(IpiRemoteCall_InvalidateTranslationSingleASID, vptr, asid, mask);
+    doRemoteMaskOpDeferred(IpiRemoteCall_InvalidateTranslationSingleASID, vptr, asid, 0, mask);
 }
 
 static inline void doRemoteInvalidateTranslationAll(word_t mask)
 {
-    doRemoteMaskOp0Arg(IpiRemoteCall_InvalidateTranslationAll, mask);
+    doRemoteMaskOpDeferred(IpiRemoteCall_InvalidateTranslationAll, 0, 0, 0, mask);
 }
 
+#ifdef CONFIG_REVOKE_BATCH
+static inline void doRemoteInvalidateTranslationASID(asid_t asid, word_t mask)
+{
+    doRemoteMaskOpDeferred(IpiRemoteCall_InvalidateTranslationASID, asid, 0, 0, mask);
+}
+#endif
+
 #ifdef CONFIG_VTX
 static inline void doRemoteClearCurrentVCPU(word_t cpu)
 {
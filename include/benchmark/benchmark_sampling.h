@@ -0,0 +1,30 @@
+/*
+ * Copyright 2020, Data61, CSIRO (ABN 41 687 119 230)
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#pragma once
+
+#include <config.h>
+#include <sel4/benchmark_sampling_types.h>
+#include <model/statedata.h>
+
+#ifdef CONFIG_BENCHMARK_SAMPLING
+extern seL4_Word ksLogIndex;
+extern seL4_Word ksLogIndexFinalized;
+
+/**
+ * @brief Empty the sample rings of all cores
+ *
+ */
+void benchmark_sampling_reset(void);
+
+/**
+ * @brief Record a sample of the current thread in this core's ring
+ *
+ * Samples are only recorded while utilisation is being tracked on this core
+ * and a log buffer is set.
+ */
+void benchmark_sampling_record(void);
+#endif /* CONFIG_BENCHMARK_SAMPLING */
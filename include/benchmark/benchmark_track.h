@@ -17,7 +17,6 @@
 
 #if defined(CONFIG_DEBUG_BUILD) || defined(CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES)
 #define TRACK_KERNEL_ENTRIES 1
-extern kernel_entry_t ksKernelEntry;
 #ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
 /**
  *  Calculate the maximum number of kernel entries that can be tracked,
@@ -27,7 +26,6 @@ extern kernel_entry_t ksKernelEntry;
 #define MAX_LOG_SIZE (seL4_LogBufferSize / \
              sizeof(benchmark_track_kernel_entry_t))
 
-extern timestamp_t ksEnter;
 extern seL4_Word ksLogIndex;
 extern seL4_Word ksLogIndexFinalized;
 
@@ -37,13 +35,36 @@ extern seL4_Word ksLogIndexFinalized;
  */
 void benchmark_track_exit(void);
 
+#ifdef CONFIG_BENCHMARK_TRACK_RING
+/**
+ * @brief Empty the kernel entry rings of all cores
+ *
+ */
+void benchmark_track_ring_reset(void);
+#endif /* CONFIG_BENCHMARK_TRACK_RING */
+
+#if CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0
+/**
+ * @brief Clear all kernel entry latency histograms
+ *
+ */
+void benchmark_track_histograms_reset(void);
+
+/**
+ * @brief Copy out a kernel entry latency histogram
+ *
+ * @return the number of entries counted in the histogram, 0 if it is not in use
+ */
+word_t benchmark_track_histogram_get(word_t index, benchmark_track_histogram_t *buffer);
+#endif /* CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0 */
+
 /**
  * @brief Start logging kernel entries
  *
  */
 static inline void benchmark_track_start(void)
 {
-    ksEnter = timestamp();
+    NODE_STATE(ksEnter) = timestamp();
 }
 #endif /* CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES */
 
@@ -51,10 +72,10 @@ static inline void benchmark_debug_syscall_start(word_t cptr, word_t msgInfo, wo
 {
     seL4_MessageInfo_t info = messageInfoFromWord_raw(msgInfo);
     lookupCapAndSlot_ret_t lu_ret = lookupCapAndSlot(NODE_STATE(ksCurThread), cptr);
-    ksKernelEntry.path = Entry_Syscall;
-    ksKernelEntry.syscall_no = -syscall;
-    ksKernelEntry.cap_type = cap_get_capType(lu_ret.cap);
-    ksKernelEntry.invocation_tag = seL4_MessageInfo_get_label(info);
+    NODE_STATE(ksKernelEntry).path = Entry_Syscall;
+    NODE_STATE(ksKernelEntry).syscall_no = -syscall;
+    NODE_STATE(ksKernelEntry).cap_type = cap_get_capType(lu_ret.cap);
+    NODE_STATE(ksKernelEntry).invocation_tag = seL4_MessageInfo_get_label(info);
 }
 #endif
 
@@ -13,11 +13,30 @@
 #include <model/statedata.h>
 
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
-extern timestamp_t ksEnter;
-
 void benchmark_track_utilisation_dump(void);
 
 void benchmark_track_reset_utilisation(tcb_t *tcb);
+
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+/* Start counting hardware events for the current thread */
+static inline void benchmark_utilisation_pmu_start(void)
+{
+    for (word_t i = 0; i < BENCHMARK_PMU_NUM_EVENTS; i++) {
+        NODE_STATE(benchmark_pmu_start)[i] = benchmark_arch_pmu_read(i);
+    }
+}
+
+/* Add the hardware events counted since the heir was switched to */
+static inline void benchmark_utilisation_pmu_switch(tcb_t *heir)
+{
+    for (word_t i = 0; i < BENCHMARK_PMU_NUM_EVENTS; i++) {
+        uint64_t count = benchmark_arch_pmu_read(i);
+        heir->benchmark.pmu_events[i] += (count - NODE_STATE(benchmark_pmu_start)[i]) & BENCHMARK_ARCH_PMU_COUNTER_MASK;
+        NODE_STATE(benchmark_pmu_start)[i] = count;
+    }
+}
+#endif /* CONFIG_BENCHMARK_UTILISATION_PMU */
+
 /* Calculate and add the utilisation time from when the heir started to run i.e. scheduled
  * and until it's being kicked off
  */
@@ -27,19 +46,22 @@ static inline void benchmark_utilisation_switch(tcb_t *heir, tcb_t *next)
     if (likely(NODE_STATE(benchmark_log_utilisation_enabled))) {
 
         /* Check if an overflow occurred while we have been in the kernel */
-        if (likely(ksEnter > heir->benchmark.schedule_start_time)) {
+        if (likely(NODE_STATE(ksEnter) > heir->benchmark.schedule_start_time)) {
 
-            heir->benchmark.utilisation += (ksEnter - heir->benchmark.schedule_start_time);
+            heir->benchmark.utilisation += (NODE_STATE(ksEnter) - heir->benchmark.schedule_start_time);
 
         } else {
 #ifdef CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT
-            heir->benchmark.utilisation += (UINT32_MAX - heir->benchmark.schedule_start_time) + ksEnter;
+            heir->benchmark.utilisation += (UINT32_MAX - heir->benchmark.schedule_start_time) + NODE_STATE(ksEnter);
             armv_handleOverflowIRQ();
 #endif /* CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT */
         }
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+        benchmark_utilisation_pmu_switch(heir);
+#endif
 
         /* Reset next thread utilisation */
-        next->benchmark.schedule_start_time = ksEnter;
+        next->benchmark.schedule_start_time = NODE_STATE(ksEnter);
         next->benchmark.number_schedules++;
         NODE_STATE(benchmark_kernel_number_schedules)++;
 
@@ -54,7 +76,7 @@ static inline void benchmark_utilisation_finalise(void)
     /* Add the time between when NODE_STATE(ksCurThread), and benchmark finalise */
     benchmark_utilisation_switch(NODE_STATE(ksCurThread), NODE_STATE(ksIdleThread));
 
-    NODE_STATE(benchmark_end_time) = ksEnter;
+    NODE_STATE(benchmark_end_time) = NODE_STATE(ksEnter);
     NODE_STATE(benchmark_log_utilisation_enabled) = false;
 }
 
@@ -8,6 +8,7 @@
 
 #include <config.h>
 #include <basic_types.h>
+#include <sel4/benchmark_utilisation_types.h>
 
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
 typedef struct {
@@ -16,6 +17,9 @@ typedef struct {
     uint64_t    number_schedules;
     uint64_t    kernel_utilisation;
     uint64_t    number_kernel_entries;
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+    uint64_t    pmu_events[BENCHMARK_PMU_NUM_EVENTS];
+#endif
 
 } benchmark_util_t;
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
@@ -6,51 +6,8 @@
 
 #pragma once
 
-/* Fastpath cap lookup.  Returns a null_cap on failure. */
-static inline cap_t FORCE_INLINE lookup_fp(cap_t cap, cptr_t cptr)
-{
-    word_t cptr2;
-    cte_t *slot;
-    word_t guardBits, radixBits, bits;
-    word_t radix, capGuard;
-
-    bits = 0;
-
-    if (unlikely(! cap_capType_equals(cap, cap_cnode_cap))) {
-        return cap_null_cap_new();
-    }
-
-    do {
-        guardBits = cap_cnode_cap_get_capCNodeGuardSize(cap);
-        radixBits = cap_cnode_cap_get_capCNodeRadix(cap);
-        cptr2 = cptr << bits;
-
-        capGuard = cap_cnode_cap_get_capCNodeGuard(cap);
-
-        /* Check the guard. Depth mismatch check is deferred.
-           The 32MinusGuardSize encoding contains an exception
-           when the guard is 0, when 32MinusGuardSize will be
-           reported as 0 also. In this case we skip the check */
-        if (likely(guardBits) && unlikely(cptr2 >> (wordBits - guardBits) != capGuard)) {
-            return cap_null_cap_new();
-        }
-
-        radix = cptr2 << guardBits >> (wordBits - radixBits);
-        slot = CTE_PTR(cap_cnode_cap_get_capCNodePtr(cap)) + radix;
+#include <kernel/cspace.h>
 
-        cap = slot->cap;
-        bits += guardBits + radixBits;
-
-    } while (unlikely(bits < wordBits && cap_capType_equals(cap, cap_cnode_cap)));
-
-    if (unlikely(bits > wordBits)) {
-        /* Depth mismatch. We've overshot wordBits bits. The lookup we've done is
-           safe, but wouldn't be allowed by the slowpath. */
-        return cap_null_cap_new();
-    }
-
-    return cap;
-}
 /* make sure the fastpath functions conform with structure_*.bf */
 static inline void thread_state_ptr_set_tsType_np(thread_state_t *ts_ptr, word_t tsType)
 {
@@ -116,3 +73,55 @@ static inline reply_t *thread_state_get_replyObject_np(thread_state_t ts)
 
 #include <arch/fastpath/fastpath.h>
 
+#ifdef CONFIG_FASTPATH_LONG_MESSAGES
+/* Longest message the fastpath transfers: the message registers followed by
+ * words from the IPC buffers, up to a cache line in total. */
+#define FASTPATH_MAX_MSG_LENGTH (L1_CACHE_LINE_SIZE / sizeof(word_t))
+compile_assert(fastpath_max_msg_length_ge_n_msgRegisters, FASTPATH_MAX_MSG_LENGTH >= n_msgRegisters)
+
+/* As fastpath_mi_check, but allowing up to FASTPATH_MAX_MSG_LENGTH words.
+ * Any extra caps appear above the length and fail the comparison. */
+static inline int fastpath_long_mi_check(word_t msgInfo)
+{
+    return (msgInfo & MASK(seL4_MsgLengthBits + seL4_MsgExtraCapBits)) > FASTPATH_MAX_MSG_LENGTH;
+}
+
+/* Look up both IPC buffers if the message does not fit in the message
+ * registers. A missing buffer truncates the message, which is left to the
+ * slowpath. */
+static inline bool_t fastpath_lookup_ipc_buffers(word_t length, tcb_t *src, tcb_t *dest,
+                                                 word_t **sendBuf, word_t **recvBuf)
+{
+    if (likely(length <= n_msgRegisters)) {
+        *sendBuf = NULL;
+        *recvBuf = NULL;
+        return true;
+    }
+
+    *sendBuf = lookupIPCBuffer(false, src);
+    *recvBuf = lookupIPCBuffer(true, dest);
+
+    return *sendBuf != NULL && *recvBuf != NULL;
+}
+
+static inline void fastpath_copy_long_mrs(word_t length, tcb_t *src, tcb_t *dest,
+                                          word_t *sendBuf, word_t *recvBuf)
+{
+    if (likely(length <= n_msgRegisters)) {
+        fastpath_copy_mrs(length, src, dest);
+        return;
+    }
+
+    fastpath_copy_mrs(n_msgRegisters, src, dest);
+    /* the first word of the buffer is the tag, as in copyMRs */
+#ifdef CONFIG_FAST_COPY_MRS
+    copyWords(&recvBuf[n_msgRegisters + 1], &sendBuf[n_msgRegisters + 1], length - n_msgRegisters);
+#else
+    word_t i;
+    for (i = n_msgRegisters; i < length; i++) {
+        recvBuf[i + 1] = sendBuf[i + 1];
+    }
+#endif
+}
+#endif /* CONFIG_FASTPATH_LONG_MESSAGES */
+
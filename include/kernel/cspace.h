@@ -59,3 +59,48 @@ resolveAddressBits_ret_t resolveAddressBits(cap_t nodeCap,
                                             cptr_t capptr,
                                             word_t n_bits);
 
+/* Fastpath cap lookup.  Returns a null_cap on failure. */
+static inline cap_t FORCE_INLINE lookup_fp(cap_t cap, cptr_t cptr)
+{
+    word_t cptr2;
+    cte_t *slot;
+    word_t guardBits, radixBits, bits;
+    word_t radix, capGuard;
+
+    bits = 0;
+
+    if (unlikely(! cap_capType_equals(cap, cap_cnode_cap))) {
+        return cap_null_cap_new();
+    }
+
+    do {
+        guardBits = cap_cnode_cap_get_capCNodeGuardSize(cap);
+        radixBits = cap_cnode_cap_get_capCNodeRadix(cap);
+        cptr2 = cptr << bits;
+
+        capGuard = cap_cnode_cap_get_capCNodeGuard(cap);
+
+        /* Check the guard. Depth mismatch check is deferred.
+           The 32MinusGuardSize encoding contains an exception
+           when the guard is 0, when 32MinusGuardSize will be
+           reported as 0 also. In this case we skip the check */
+        if (likely(guardBits) && unlikely(cptr2 >> (wordBits - guardBits) != capGuard)) {
+            return cap_null_cap_new();
+        }
+
+        radix = cptr2 << guardBits >> (wordBits - radixBits);
+        slot = CTE_PTR(cap_cnode_cap_get_capCNodePtr(cap)) + radix;
+
+        cap = slot->cap;
+        bits += guardBits + radixBits;
+
+    } while (unlikely(bits < wordBits && cap_capType_equals(cap, cap_cnode_cap)));
+
+    if (unlikely(bits > wordBits)) {
+        /* Depth mismatch. We've overshot wordBits bits. The lookup we've done is
+           safe, but wouldn't be allowed by the slowpath. */
+        return cap_null_cap_new();
+    }
+
+    return cap;
+}
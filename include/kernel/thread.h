@@ -65,18 +65,18 @@ static inline prio_t getHighestPrio(word_t dom)
     word_t l1index_inverted;
 
     /* it's undefined to call clzl on 0 */
-    assert(NODE_STATE(ksReadyQueuesL1Bitmap)[dom] != 0);
+    assert(READY_QUEUES_L1_BITMAP(dom) != 0);
 
-    l1index = wordBits - 1 - clzl(NODE_STATE(ksReadyQueuesL1Bitmap)[dom]);
+    l1index = wordBits - 1 - clzl(READY_QUEUES_L1_BITMAP(dom));
     l1index_inverted = invert_l1index(l1index);
-    assert(NODE_STATE(ksReadyQueuesL2Bitmap)[dom][l1index_inverted] != 0);
-    l2index = wordBits - 1 - clzl(NODE_STATE(ksReadyQueuesL2Bitmap)[dom][l1index_inverted]);
+    assert(READY_QUEUES_L2_BITMAP(dom, l1index_inverted) != 0);
+    l2index = wordBits - 1 - clzl(READY_QUEUES_L2_BITMAP(dom, l1index_inverted));
     return (l1index_to_prio(l1index) | l2index);
 }
 
 static inline bool_t isHighestPrio(word_t dom, prio_t prio)
 {
-    return NODE_STATE(ksReadyQueuesL1Bitmap)[dom] == 0 ||
+    return READY_QUEUES_L1_BITMAP(dom) == 0 ||
            prio >= getHighestPrio(dom);
 }
 
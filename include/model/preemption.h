@@ -9,4 +9,7 @@
 #include <api/failures.h>
 
 exception_t preemptionPoint(void);
+#ifdef CONFIG_PREEMPTION_BUDGET
+void preemptionBudgetStart(void);
+#endif
 
@@ -11,6 +11,7 @@
 #include <object/structures.h>
 #include <object/tcb.h>
 #include <mode/types.h>
+#include <sel4/benchmark_track_types.h>
 
 #ifdef ENABLE_SMP_SUPPORT
 #define NODE_STATE_BEGIN(_name)                 typedef struct _name {
@@ -55,10 +56,25 @@
 #define NUM_READY_QUEUES (CONFIG_NUM_DOMAINS * CONFIG_NUM_PRIORITIES)
 #define L2_BITMAP_SIZE ((CONFIG_NUM_PRIORITIES + wordBits - 1) / wordBits)
 
+#ifdef CONFIG_PACKED_READY_QUEUES
+/* The scheduler state of one domain. The queues are indexed by inverted
+ * priority, for the same reason as the second level of the bitmap, so that
+ * the heads of the highest priority queues follow the bitmap in its cache line */
+typedef struct ready_queues_domain {
+    word_t l1Bitmap;
+    word_t l2Bitmap[L2_BITMAP_SIZE];
+    tcb_queue_t queues[CONFIG_NUM_PRIORITIES];
+} ALIGN(L1_CACHE_LINE_SIZE) ready_queues_domain_t;
+#endif
+
 NODE_STATE_BEGIN(nodeState)
+#ifdef CONFIG_PACKED_READY_QUEUES
+NODE_STATE_DECLARE(ready_queues_domain_t, ksReadyQueuesDomains[CONFIG_NUM_DOMAINS]);
+#else
 NODE_STATE_DECLARE(tcb_queue_t, ksReadyQueues[NUM_READY_QUEUES]);
 NODE_STATE_DECLARE(word_t, ksReadyQueuesL1Bitmap[CONFIG_NUM_DOMAINS]);
 NODE_STATE_DECLARE(word_t, ksReadyQueuesL2Bitmap[CONFIG_NUM_DOMAINS][L2_BITMAP_SIZE]);
+#endif
 NODE_STATE_DECLARE(tcb_t, *ksCurThread);
 NODE_STATE_DECLARE(tcb_t, *ksIdleThread);
 NODE_STATE_DECLARE(tcb_t, *ksSchedulerAction);
@@ -87,7 +103,19 @@ NODE_STATE_DECLARE(timestamp_t, benchmark_end_time);
 NODE_STATE_DECLARE(timestamp_t, benchmark_kernel_time);
 NODE_STATE_DECLARE(timestamp_t, benchmark_kernel_number_entries);
 NODE_STATE_DECLARE(timestamp_t, benchmark_kernel_number_schedules);
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+/* Hardware event counts when the current thread was switched to */
+NODE_STATE_DECLARE(uint64_t, benchmark_pmu_start[BENCHMARK_PMU_NUM_EVENTS]);
+#endif
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
+#if defined CONFIG_DEBUG_BUILD || defined CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
+/* Details of the current kernel entry, filled in as it is decoded */
+NODE_STATE_DECLARE(kernel_entry_t, ksKernelEntry);
+#endif
+#if defined CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES || defined CONFIG_BENCHMARK_TRACK_UTILISATION
+/* Time stamp of the current kernel entry */
+NODE_STATE_DECLARE(timestamp_t, ksEnter);
+#endif
 
 NODE_STATE_END(nodeState);
 
@@ -99,6 +127,12 @@ extern word_t ksNumCPUs;
 #define INT_STATE_ARRAY_SIZE (maxIRQ + 1)
 #endif
 extern word_t ksWorkUnitsCompleted;
+#ifdef CONFIG_PREEMPTION_BUDGET
+extern uint64_t ksPreemptionCheckTime;
+#endif
+#ifdef CONFIG_UNTYPED_BACKGROUND_RESET
+extern cte_t *ksUntypedBackgroundReset[CONFIG_UNTYPED_BACKGROUND_RESET_SLOTS];
+#endif
 extern irq_state_t intStateIRQTable[];
 extern cte_t intStateIRQNode[];
 
@@ -130,3 +164,24 @@ extern paddr_t ksUserLogBuffer;
 #define ARCH_NODE_STATE(_state)    ARCH_NODE_STATE_ON_CORE(_state, getCurrentCPUIndex())
 #define NODE_STATE(_state)         NODE_STATE_ON_CORE(_state, getCurrentCPUIndex())
 
+/* Accessors for the ready queues and scheduler bitmap of a domain, which hide
+ * whether they are packed per domain */
+#ifdef CONFIG_PACKED_READY_QUEUES
+#define READY_QUEUE_ON_CORE(_dom, _prio, _core) \
+    NODE_STATE_ON_CORE(ksReadyQueuesDomains[_dom], _core).queues[CONFIG_NUM_PRIORITIES - 1 - (_prio)]
+#define READY_QUEUES_L1_BITMAP_ON_CORE(_dom, _core) \
+    NODE_STATE_ON_CORE(ksReadyQueuesDomains[_dom], _core).l1Bitmap
+#define READY_QUEUES_L2_BITMAP_ON_CORE(_dom, _index, _core) \
+    NODE_STATE_ON_CORE(ksReadyQueuesDomains[_dom], _core).l2Bitmap[_index]
+#else
+#define READY_QUEUE_ON_CORE(_dom, _prio, _core) \
+    NODE_STATE_ON_CORE(ksReadyQueues[ready_queues_index(_dom, _prio)], _core)
+#define READY_QUEUES_L1_BITMAP_ON_CORE(_dom, _core) \
+    NODE_STATE_ON_CORE(ksReadyQueuesL1Bitmap[_dom], _core)
+#define READY_QUEUES_L2_BITMAP_ON_CORE(_dom, _index, _core) \
+    NODE_STATE_ON_CORE(ksReadyQueuesL2Bitmap[_dom][_index], _core)
+#endif
+#define READY_QUEUE(_dom, _prio) READY_QUEUE_ON_CORE(_dom, _prio, getCurrentCPUIndex())
+#define READY_QUEUES_L1_BITMAP(_dom) READY_QUEUES_L1_BITMAP_ON_CORE(_dom, getCurrentCPUIndex())
+#define READY_QUEUES_L2_BITMAP(_dom, _index) READY_QUEUES_L2_BITMAP_ON_CORE(_dom, _index, getCurrentCPUIndex())
+
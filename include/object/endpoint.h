@@ -31,6 +31,11 @@ void sendIPC(bool_t blocking, bool_t do_call, word_t badge,
              endpoint_t *epptr);
 void receiveIPC(tcb_t *thread, cap_t cap, bool_t isBlocking);
 #endif
+#ifdef CONFIG_BATCHED_IPC
+/* Send a message without caps to a thread waiting on 'epptr', without
+ * blocking. Returns false, changing nothing, if no thread is waiting. */
+bool_t sendBatchedIPC(word_t badge, seL4_MessageInfo_t info, word_t *msg, endpoint_t *epptr);
+#endif
 void cancelIPC(tcb_t *tptr);
 void cancelAllIPC(endpoint_t *epptr);
 void cancelBadgedSends(endpoint_t *epptr, word_t badge);
@@ -288,6 +288,11 @@ struct tcb {
     /* userland virtual address of thread IPC buffer, 1 word */
     word_t tcbIPCBuffer;
 
+#ifdef CONFIG_IPC_PAGE_GRANT
+    /* userland virtual address at which to map a received frame, or 0, 1 word */
+    word_t tcbReceiveWindow;
+#endif
+
 #ifdef ENABLE_SMP_SUPPORT
     /* cpu ID this thread is running on, 1 word */
     word_t tcbAffinity;
@@ -303,6 +308,12 @@ struct tcb {
 #ifdef CONFIG_KERNEL_MCS
     /* if tcb is in a call, pointer to the reply object, 1 word */
     reply_t *tcbReply;
+#ifdef CONFIG_RELEASE_QUEUE_HEAP
+    /* leftmost child in the release heap, 1 word. Siblings are linked through
+     * tcbSchedNext, and tcbSchedPrev points to the left sibling or, for the
+     * leftmost child, the parent */
+    struct tcb *tcbReleaseChild;
+#endif
 #endif
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
     /* 16 bytes (12 bytes aarch32) */
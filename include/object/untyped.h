@@ -34,3 +34,27 @@ exception_t invokeUntyped_Retype(cte_t *srcSlot, bool_t reset,
                                  void *retypeBase, object_t newType, word_t userSize,
                                  cte_t *destCNode, word_t destOffset, word_t destLength,
                                  bool_t deviceMemory);
+#ifdef CONFIG_UNTYPED_BACKGROUND_RESET
+exception_t invokeUntyped_BackgroundReset(cte_t *srcSlot);
+void untypedBackgroundReset(void);
+void untypedBackgroundResetSwap(cte_t *slot1, cte_t *slot2);
+void untypedBackgroundResetRemove(cte_t *slot);
+#endif
+
+#ifdef CONFIG_UNTYPED_RETYPE_BATCH
+/* A validated group of a RetypeBatch invocation. regionOffset is the offset
+ * of its first object from the base of the untyped. */
+struct untyped_retype_group {
+    object_t newType;
+    word_t userSize;
+    word_t regionOffset;
+    word_t destOffset;
+    word_t destLength;
+};
+typedef struct untyped_retype_group untyped_retype_group_t;
+
+exception_t invokeUntyped_RetypeBatch(cte_t *srcSlot, bool_t reset,
+                                      untyped_retype_group_t *groups, word_t numGroups,
+                                      cte_t *destCNode, word_t freeOffset,
+                                      bool_t deviceMemory);
+#endif
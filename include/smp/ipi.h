@@ -84,6 +84,84 @@ void handleIPI(irq_t irq, bool_t irqPath);
  */
 void doRemoteMaskOp(IpiRemoteCall_t func, word_t data1, word_t data2, word_t data3, word_t mask);
 
+/* Architecture specific: run one remote call on the current core. */
+void handleRemoteCallOp(IpiRemoteCall_t call, word_t arg0, word_t arg1, word_t arg2, bool_t irqPath);
+
+#ifdef CONFIG_SMP_BATCHED_REMOTE_CALLS
+#define MAX_BATCHED_REMOTE_CALLS 8 /* Maximum number of calls queued for one core */
+
+typedef struct remote_call {
+    IpiRemoteCall_t func;
+    word_t args[MAX_IPI_ARGS];
+} remote_call_t;
+
+/* Remote calls queued for one core, as a ring. Calls [tail, head) have been
+ * sent to the core and calls [head, queued) are still being collected. Only
+ * the holder of the big kernel lock adds calls and moves head, and only the
+ * core itself runs calls and moves tail. */
+typedef struct remote_call_batch {
+    word_t queued;
+    word_t head;
+    word_t tail;
+    remote_call_t calls[MAX_BATCHED_REMOTE_CALLS];
+} remote_call_batch_t;
+
+extern remote_call_batch_t remoteCallBatch[CONFIG_MAX_NUM_NODES];
+extern word_t remoteCallBatchMask;
+/* Number of remote-call IPIs that batching has avoided sending */
+extern word_t remoteCallIPIsSaved;
+
+/*
+ * Queue a function to run on all cores specified by mask. The calls queued for
+ * a core are run, in order, once doRemoteCallBatchFlush has sent them with a
+ * single IPI. A call that is already waiting to be sent to a core is not queued
+ * again. Caller must hold the lock.
+ */
+void doRemoteMaskOpBatched(IpiRemoteCall_t func, word_t data1, word_t data2, word_t data3, word_t mask);
+
+/* Send all queued remote calls, with one IPI per core. This is done before the
+ * lock is released. Unless TLB shootdowns are lazy, it waits for the calls to
+ * have run, with a single barrier. */
+void doRemoteCallBatchFlush(void);
+
+/* Run the calls that have been sent to the current core */
+void handleRemoteCallBatch(bool_t irqPath);
+
+#ifdef CONFIG_SMP_LAZY_TLB_SHOOTDOWN
+/* Wait until every core has run all the calls queued for it. This must be done
+ * before memory that may still be reachable through stale translations on
+ * other cores is reused. Caller must hold the lock. */
+void doRemoteCallBatchWait(void);
+
+/* Cores run their sent calls on every kernel entry */
+static inline void remoteCallBatchEntry(void)
+{
+    remote_call_batch_t *batch = &remoteCallBatch[getCurrentCPUIndex()];
+
+    if (unlikely(__atomic_load_n(&batch->head, __ATOMIC_RELAXED) != batch->tail)) {
+        handleRemoteCallBatch(false);
+    }
+}
+#endif /* CONFIG_SMP_LAZY_TLB_SHOOTDOWN */
+#endif /* CONFIG_SMP_BATCHED_REMOTE_CALLS */
+
+/*
+ * Run a function on all cores specified by mask, for functions whose effect
+ * only has to be complete when this core leaves the kernel, such as TLB
+ * invalidations. With batched remote calls these are queued and sent together
+ * on the way out of the kernel, otherwise this is doRemoteMaskOp. With lazy TLB
+ * shootdowns the other cores run them on their next kernel entry.
+ */
+static void inline doRemoteMaskOpDeferred(IpiRemoteCall_t func, word_t data1, word_t data2, word_t data3,
+                                          word_t mask)
+{
+#ifdef CONFIG_SMP_BATCHED_REMOTE_CALLS
+    doRemoteMaskOpBatched(func, data1, data2, data3, mask);
+#else
+    doRemoteMaskOp(func, data1, data2, data3, mask);
+#endif
+}
+
 /* Run a synchronous function on a core specified by cpu.
  *
  * @param func the function to run
@@ -16,6 +16,13 @@
 
 #ifdef ENABLE_SMP_SUPPORT
 
+/* The big kernel lock. Its implementation is selected with KernelSMPLock; every
+ * backend provides the same kernel_lock_* interface below. Each backend keeps a
+ * per-core entry in big_kernel_lock.node_owners with the software IPI flag 'ipi',
+ * which a core waiting for the lock polls so that it can serve remote calls. */
+
+#if defined(CONFIG_SMP_LOCK_CLH)
+
 /* CLH lock is FIFO lock for machines with coherent caches (coherent-FIFO lock).
  * See ftp://ftp.cs.washington.edu/tr/1993/02/UW-CSE-93-02-02.pdf */
 
@@ -49,18 +56,236 @@ typedef struct clh_lock {
     PAD_TO_NEXT_CACHE_LN(sizeof(clh_qnode_t *));
 } clh_lock_t;
 
-extern clh_lock_t big_kernel_lock;
-BOOT_CODE void clh_lock_init(void);
+typedef clh_lock_t kernel_lock_t;
+
+#elif defined(CONFIG_SMP_LOCK_MCS_QUEUE)
+
+/* Mellor-Crummey and Scott queue lock. Unlike CLH, a waiter spins on its own
+ * node, which its predecessor writes once on release. All the writes other
+ * cores make for a waiter therefore land on the one cache line it spins on.
+ * See https://doi.org/10.1145/103727.103729 */
+
+typedef struct mcs_qnode {
+    struct mcs_qnode *next;
+    word_t locked;
+    word_t queued;
+    /* This is the software IPI flag */
+    word_t ipi;
+
+    PAD_TO_NEXT_CACHE_LN(sizeof(struct mcs_qnode *) + 3 * sizeof(word_t));
+} mcs_qnode_t;
+
+typedef struct mcs_queue_lock {
+    mcs_qnode_t node_owners[CONFIG_MAX_NUM_NODES];
+
+    mcs_qnode_t *tail;
+    PAD_TO_NEXT_CACHE_LN(sizeof(mcs_qnode_t *));
+} mcs_queue_lock_t;
+
+typedef mcs_queue_lock_t kernel_lock_t;
+
+#else /* CONFIG_SMP_LOCK_TICKET || CONFIG_SMP_LOCK_COHORT */
+
+typedef struct ticket_counter {
+    word_t value;
+
+    PAD_TO_NEXT_CACHE_LN(sizeof(word_t));
+} ticket_counter_t;
+
+typedef struct ticket_owner {
+    word_t ticket;
+#ifdef CONFIG_SMP_LOCK_COHORT
+    word_t globalTicket;
+    word_t phase;
+#endif
+    word_t queued;
+    /* This is the software IPI flag */
+    word_t ipi;
+
+#ifdef CONFIG_SMP_LOCK_COHORT
+    PAD_TO_NEXT_CACHE_LN(5 * sizeof(word_t));
+#else
+    PAD_TO_NEXT_CACHE_LN(3 * sizeof(word_t));
+#endif
+} ticket_owner_t;
+
+#ifdef CONFIG_SMP_LOCK_TICKET
+
+/* Ticket lock. Waiters are served in FIFO order and all of them spin on the
+ * same 'serving' counter. Acquisition is a single fetch-and-add, which makes it
+ * the cheapest backend when there are few cores. */
+
+typedef struct ticket_lock {
+    ticket_owner_t node_owners[CONFIG_MAX_NUM_NODES];
+
+    ticket_counter_t next;
+    ticket_counter_t serving;
+} ticket_lock_t;
+
+typedef ticket_lock_t kernel_lock_t;
+
+#else /* CONFIG_SMP_LOCK_COHORT */
+
+/* Cohort lock built from ticket locks, see https://doi.org/10.1145/2686884.
+ * Cores are grouped into clusters of CONFIG_SMP_LOCK_CLUSTER_SIZE consecutive
+ * indices. A core first takes its cluster's lock and then the global one, but
+ * a holder that sees another core of its cluster waiting passes the global lock
+ * on with the cluster lock. This keeps the lock, and the kernel data it
+ * protects, within one cluster for up to COHORT_MAX_LOCAL_HANDOFFS entries. */
+
+#define COHORT_NUM_CLUSTERS \
+    ((CONFIG_MAX_NUM_NODES + CONFIG_SMP_LOCK_CLUSTER_SIZE - 1) / CONFIG_SMP_LOCK_CLUSTER_SIZE)
+#define COHORT_MAX_LOCAL_HANDOFFS 64
+
+enum cohort_phase {
+    CohortPhase_Cluster = 0,
+    CohortPhase_Global,
+    CohortPhase_Held
+};
 
-static inline bool_t FORCE_INLINE clh_is_ipi_pending(word_t cpu)
+typedef struct cohort_cluster {
+    ticket_counter_t next;
+    ticket_counter_t serving;
+
+    /* only accessed by the holder of the cluster lock */
+    word_t globalHeld;
+    word_t handoffs;
+    PAD_TO_NEXT_CACHE_LN(2 * sizeof(word_t));
+} cohort_cluster_t;
+
+typedef struct cohort_lock {
+    ticket_owner_t node_owners[CONFIG_MAX_NUM_NODES];
+    cohort_cluster_t clusters[COHORT_NUM_CLUSTERS];
+
+    ticket_counter_t next;
+    ticket_counter_t serving;
+} cohort_lock_t;
+
+typedef cohort_lock_t kernel_lock_t;
+
+static inline word_t CONST cohort_cluster_of(word_t cpu)
+{
+    return cpu / CONFIG_SMP_LOCK_CLUSTER_SIZE;
+}
+
+#endif /* CONFIG_SMP_LOCK_TICKET */
+#endif /* CONFIG_SMP_LOCK_CLH */
+
+extern kernel_lock_t big_kernel_lock;
+BOOT_CODE void kernel_lock_init(void);
+
+static inline bool_t FORCE_INLINE kernel_lock_is_ipi_pending(word_t cpu)
 {
     return big_kernel_lock.node_owners[cpu].ipi == 1;
 }
 
-static inline void *sel4_atomic_exchange(void *ptr, bool_t
+/* Whether the lock is neither held nor waited for by any core */
+static inline bool_t FORCE_INLINE kernel_lock_is_free(void)
+{
+#if defined(CONFIG_SMP_LOCK_CLH)
+    clh_qnode_t *head = __atomic_load_n(&big_kernel_lock.head, __ATOMIC_RELAXED);
+    return __atomic_load_n(&head->value, __ATOMIC_RELAXED) == CLHState_Granted;
+#elif defined(CONFIG_SMP_LOCK_MCS_QUEUE)
+    return __atomic_load_n(&big_kernel_lock.tail, __ATOMIC_RELAXED) == NULL;
+#else
+    /* with the cohort lock, the global lock stays taken while a cluster holds it */
+    word_t next = __atomic_load_n(&big_kernel_lock.next.value, __ATOMIC_RELAXED);
+    return __atomic_load_n(&big_kernel_lock.serving.value, __ATOMIC_RELAXED) == next;
+#endif
+}
+
+#ifdef CONFIG_SMP_CORE_LOCAL_ENTRIES
+/* Number of locks that endpoints share by address for core-local IPC, a power of 2 */
+#define CORE_LOCAL_EP_LOCKS 64
+
+typedef struct core_local_ep_lock {
+    word_t locked;
+
+    PAD_TO_NEXT_CACHE_LN(sizeof(word_t));
+} core_local_ep_lock_t;
+
+extern core_local_ep_lock_t core_local_ep_locks[CORE_LOCAL_EP_LOCKS];
+
+/* A core sets its flag while it runs a kernel entry that touches only state
+ * owned by that core, without holding the big kernel lock. Such entries never
+ * wait for anything, so the lock holder can simply wait for them to finish. */
+typedef struct core_local_entry {
+    word_t active;
+    /* endpoint lock held by a core-local IPC fastpath, or NULL */
+    core_local_ep_lock_t *epLock;
+
+    PAD_TO_NEXT_CACHE_LN(sizeof(word_t) + sizeof(core_local_ep_lock_t *));
+} core_local_entry_t;
+
+extern core_local_entry_t core_local_entries[CONFIG_MAX_NUM_NODES];
+
+/* Try to enter the kernel without the big kernel lock. This is a Dekker-style
+ * handshake with kernel_lock_wait_core_local_entries: either this core sees the
+ * lock held or queued and backs off, or the lock taker sees the flag and waits. */
+static inline bool_t FORCE_INLINE core_local_enter(word_t cpu)
+{
+    __atomic_store_n(&core_local_entries[cpu].active, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (likely(kernel_lock_is_free())) {
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        return true;
+    }
+
+    __atomic_store_n(&core_local_entries[cpu].active, 0, __ATOMIC_RELAXED);
+    return false;
+}
+
+static inline void FORCE_INLINE core_local_exit(word_t cpu)
+{
+    core_local_ep_lock_t *lock = core_local_entries[cpu].epLock;
+
+    if (lock) {
+        core_local_entries[cpu].epLock = NULL;
+        __atomic_store_n(&lock->locked, 0, __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&core_local_entries[cpu].active, 0, __ATOMIC_RELEASE);
+}
+
+/* An IPC fastpath running as a core-local entry dequeues from or enqueues on
+ * an endpoint that a fastpath on another core, also without the big kernel
+ * lock, may be using at the same time. It holds the endpoint's lock from
+ * before it first reads the endpoint until core_local_exit. Like the entry
+ * itself this never waits: if the lock is taken the fastpath gives up before
+ * changing anything and the syscall is started again under the big kernel lock. */
+static inline bool_t FORCE_INLINE core_local_try_lock_ep(word_t cpu, void *ep)
+{
+    core_local_ep_lock_t *lock =
+        &core_local_ep_locks[((word_t)ep >> seL4_EndpointBits) & (CORE_LOCAL_EP_LOCKS - 1)];
+
+    if (__atomic_exchange_n(&lock->locked, 1, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    core_local_entries[cpu].epLock = lock;
+    return true;
+}
+
+static inline void FORCE_INLINE kernel_lock_wait_core_local_entries(word_t cpu)
+{
+    /* order our enqueue on the lock before reading the flags */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        if (i != cpu) {
+            while (__atomic_load_n(&core_local_entries[i].active, __ATOMIC_RELAXED)) {
+                arch_pause();
+            }
+        }
+    }
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+#endif /* CONFIG_SMP_CORE_LOCAL_ENTRIES */
+
+static inline void *sel4_atomic_exchange(void *ptr, void *new_val, bool_t
                                          irqPath, word_t cpu, int memorder)
 {
-    clh_qnode_t *prev;
+    void *prev;
 
     if (memorder == __ATOMIC_RELEASE || memorder == __ATOMIC_ACQ_REL) {
         __atomic_thread_fence(__ATOMIC_RELEASE);
@@ -68,10 +293,8 @@ static inline void *sel4_atomic_exchange(void *ptr, bool_t
         __atomic_thread_fence(__ATOMIC_SEQ_CST);
     }
 
-    while (!try_arch_atomic_exchange_rlx(&big_kernel_lock.head,
-                                         (void *) big_kernel_lock.node_owners[cpu].node,
-                                         (void **) &prev)) {
-        if (clh_is_ipi_pending(cpu)) {
+    while (!try_arch_atomic_exchange_rlx(ptr, new_val, &prev)) {
+        if (kernel_lock_is_ipi_pending(cpu)) {
             /* we only handle irq_remote_call_ipi here as other type of IPIs
              * are async and could be delayed. 'handleIPI' may not return
              * based on value of the 'irqPath'. */
@@ -90,22 +313,94 @@ static inline void *sel4_atomic_exchange(void *ptr, bool_t
     return prev;
 }
 
-static inline void FORCE_INLINE clh_lock_acquire(word_t cpu, bool_t irqPath)
+/* Join the queue for the lock. Afterwards kernel_lock_is_self_in_queue holds
+ * and the core waits for kernel_lock_is_granted. */
+static inline void FORCE_INLINE kernel_lock_enqueue(word_t cpu, bool_t irqPath)
 {
-    clh_qnode_t *prev;
+#if defined(CONFIG_SMP_LOCK_CLH)
     big_kernel_lock.node_owners[cpu].node->value = CLHState_Pending;
 
-    prev = sel4_atomic_exchange(&big_kernel_lock.head, irqPath, cpu, __ATOMIC_ACQ_REL);
+    big_kernel_lock.node_owners[cpu].next =
+        sel4_atomic_exchange(&big_kernel_lock.head, big_kernel_lock.node_owners[cpu].node,
+                             irqPath, cpu, __ATOMIC_ACQ_REL);
+#elif defined(CONFIG_SMP_LOCK_MCS_QUEUE)
+    mcs_qnode_t *node = &big_kernel_lock.node_owners[cpu];
+    mcs_qnode_t *prev;
+
+    node->next = NULL;
+    node->locked = 1;
+    node->queued = 1;
+
+    prev = sel4_atomic_exchange(&big_kernel_lock.tail, node, irqPath, cpu, __ATOMIC_ACQ_REL);
+    if (prev == NULL) {
+        node->locked = 0;
+    } else {
+        __atomic_store_n(&prev->next, node, __ATOMIC_RELEASE);
+    }
+#else
+    ticket_owner_t *owner = &big_kernel_lock.node_owners[cpu];
+
+    owner->queued = 1;
+#ifdef CONFIG_SMP_LOCK_COHORT
+    owner->phase = CohortPhase_Cluster;
+    owner->ticket = __atomic_fetch_add(&big_kernel_lock.clusters[cohort_cluster_of(cpu)].next.value,
+                                       1, __ATOMIC_ACQ_REL);
+#else
+    owner->ticket = __atomic_fetch_add(&big_kernel_lock.next.value, 1, __ATOMIC_ACQ_REL);
+#endif
+#endif
+}
 
-    big_kernel_lock.node_owners[cpu].next = prev;
+/* Whether this core, which is in the queue, now holds the lock. With the
+ * cohort lock this also moves the core on from its cluster's lock to the
+ * global one. */
+static inline bool_t FORCE_INLINE kernel_lock_is_granted(word_t cpu)
+{
+#if defined(CONFIG_SMP_LOCK_CLH)
+    return big_kernel_lock.node_owners[cpu].next->value == CLHState_Granted;
+#elif defined(CONFIG_SMP_LOCK_MCS_QUEUE)
+    return __atomic_load_n(&big_kernel_lock.node_owners[cpu].locked, __ATOMIC_RELAXED) == 0;
+#elif defined(CONFIG_SMP_LOCK_TICKET)
+    return __atomic_load_n(&big_kernel_lock.serving.value, __ATOMIC_RELAXED) ==
+           big_kernel_lock.node_owners[cpu].ticket;
+#else
+    ticket_owner_t *owner = &big_kernel_lock.node_owners[cpu];
+    cohort_cluster_t *cluster = &big_kernel_lock.clusters[cohort_cluster_of(cpu)];
+
+    if (owner->phase == CohortPhase_Cluster) {
+        if (__atomic_load_n(&cluster->serving.value, __ATOMIC_ACQUIRE) != owner->ticket) {
+            return false;
+        }
+        if (cluster->globalHeld) {
+            owner->phase = CohortPhase_Held;
+            return true;
+        }
+        owner->globalTicket = __atomic_fetch_add(&big_kernel_lock.next.value, 1, __ATOMIC_ACQ_REL);
+        owner->phase = CohortPhase_Global;
+    }
+
+    if (owner->phase == CohortPhase_Global) {
+        if (__atomic_load_n(&big_kernel_lock.serving.value, __ATOMIC_RELAXED) != owner->globalTicket) {
+            return false;
+        }
+        owner->phase = CohortPhase_Held;
+    }
+
+    return true;
+#endif
+}
+
+static inline void FORCE_INLINE kernel_lock_acquire(word_t cpu, bool_t irqPath)
+{
+    kernel_lock_enqueue(cpu, irqPath);
 
     /* We do not have an __atomic_thread_fence here as this is already handled by the
-     * atomic_exchange just above */
-    while (big_kernel_lock.node_owners[cpu].next->value != CLHState_Granted) {
+     * atomic operation in kernel_lock_enqueue */
+    while (!kernel_lock_is_granted(cpu)) {
         /* As we are in a loop we need to ensure that any loads of future iterations of the
          * loop are performed after this one */
         __atomic_thread_fence(__ATOMIC_ACQUIRE);
-        if (clh_is_ipi_pending(cpu)) {
+        if (kernel_lock_is_ipi_pending(cpu)) {
             /* we only handle irq_remote_call_ipi here as other type of IPIs
              * are async and could be delayed. 'handleIPI' may not return
              * based on value of the 'irqPath'. */
@@ -116,31 +411,86 @@ static inline void FORCE_INLINE clh_lock_acquire(word_t cpu, bool_t irqPath)
         arch_pause();
     }
 
+#ifdef CONFIG_SMP_CORE_LOCAL_ENTRIES
+    kernel_lock_wait_core_local_entries(cpu);
+#endif
+
     /* make sure no resource access passes from this point */
     __atomic_thread_fence(__ATOMIC_ACQUIRE);
 }
 
-static inline void FORCE_INLINE clh_lock_release(word_t cpu)
+static inline void FORCE_INLINE kernel_lock_release(word_t cpu)
 {
     /* make sure no resource access passes from this point */
     __atomic_thread_fence(__ATOMIC_RELEASE);
 
+#if defined(CONFIG_SMP_LOCK_CLH)
     big_kernel_lock.node_owners[cpu].node->value = CLHState_Granted;
     big_kernel_lock.node_owners[cpu].node =
         big_kernel_lock.node_owners[cpu].next;
+#elif defined(CONFIG_SMP_LOCK_MCS_QUEUE)
+    mcs_qnode_t *node = &big_kernel_lock.node_owners[cpu];
+    mcs_qnode_t *next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE);
+
+    node->queued = 0;
+    if (next == NULL) {
+        mcs_qnode_t *expected = node;
+        if (__atomic_compare_exchange_n(&big_kernel_lock.tail, &expected, NULL, false,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED)) {
+            return;
+        }
+        /* a successor has swapped itself in but not linked itself to us yet */
+        while ((next = __atomic_load_n(&node->next, __ATOMIC_ACQUIRE)) == NULL) {
+            arch_pause();
+        }
+    }
+    __atomic_store_n(&next->locked, 0, __ATOMIC_RELEASE);
+#elif defined(CONFIG_SMP_LOCK_TICKET)
+    big_kernel_lock.node_owners[cpu].queued = 0;
+    __atomic_store_n(&big_kernel_lock.serving.value, big_kernel_lock.node_owners[cpu].ticket + 1,
+                     __ATOMIC_RELEASE);
+#else
+    ticket_owner_t *owner = &big_kernel_lock.node_owners[cpu];
+    cohort_cluster_t *cluster = &big_kernel_lock.clusters[cohort_cluster_of(cpu)];
+
+    owner->queued = 0;
+    if (__atomic_load_n(&cluster->next.value, __ATOMIC_RELAXED) != owner->ticket + 1 &&
+        cluster->handoffs < COHORT_MAX_LOCAL_HANDOFFS) {
+        /* another core of this cluster is waiting, pass the global lock on to it */
+        cluster->globalHeld = true;
+        cluster->handoffs++;
+    } else {
+        cluster->globalHeld = false;
+        cluster->handoffs = 0;
+        __atomic_store_n(&big_kernel_lock.serving.value, big_kernel_lock.serving.value + 1,
+                         __ATOMIC_RELEASE);
+    }
+    __atomic_store_n(&cluster->serving.value, owner->ticket + 1, __ATOMIC_RELEASE);
+#endif
 }
 
-static inline bool_t FORCE_INLINE clh_is_self_in_queue(void)
+static inline bool_t FORCE_INLINE kernel_lock_is_self_in_queue(void)
 {
+#if defined(CONFIG_SMP_LOCK_CLH)
     return big_kernel_lock.node_owners[getCurrentCPUIndex()].node->value == CLHState_Pending;
+#else
+    return big_kernel_lock.node_owners[getCurrentCPUIndex()].queued;
+#endif
 }
 
+#ifdef CONFIG_SMP_BATCHED_REMOTE_CALLS
+/* Remote calls queued during a kernel entry are sent before the lock is released */
+#define REMOTE_CALL_BATCH_FLUSH doRemoteCallBatchFlush()
+#else
+#define REMOTE_CALL_BATCH_FLUSH do {} while (0)
+#endif
+
 #define NODE_LOCK(_irqPath) do {                         \
-    clh_lock_acquire(getCurrentCPUIndex(), _irqPath);    \
+    kernel_lock_acquire(getCurrentCPUIndex(), _irqPath); \
 } while(0)
 
 #define NODE_UNLOCK do {                                 \
-    clh_lock_release(getCurrentCPUIndex());              \
+    kernel_lock_release(getCurrentCPUIndex());           \
 } while(0)
 
 #define NODE_LOCK_IF(_cond, _irqPath) do {               \
@@ -149,21 +499,52 @@ static inline bool_t FORCE_INLINE clh_is_self_in_queue(void)
     }                                                    \
 } while(0)
 
+#ifdef CONFIG_SMP_CORE_LOCAL_ENTRIES
+/* Like NODE_LOCK_IF, but the lock is not taken if _local holds and this core
+ * can run the entry on its own */
+#define NODE_LOCK_IF_NOT_CORE_LOCAL(_cond, _local, _irqPath) do {      \
+    if((_cond) && (!(_local) || !core_local_enter(getCurrentCPUIndex()))) { \
+        NODE_LOCK(_irqPath);                                           \
+    }                                                                  \
+} while(0)
+
 #define NODE_UNLOCK_IF_HELD do {                         \
-    if(clh_is_self_in_queue()) {                         \
+    if(kernel_lock_is_self_in_queue()) {                 \
+        REMOTE_CALL_BATCH_FLUSH;                         \
         NODE_UNLOCK;                                     \
+    } else {                                             \
+        core_local_exit(getCurrentCPUIndex());           \
     }                                                    \
 } while(0)
 
+/* Call and ReplyRecv fastpaths may run as core-local entries */
+#define NODE_UNLOCK_FASTPATH NODE_UNLOCK_IF_HELD
+#else
+#define NODE_LOCK_IF_NOT_CORE_LOCAL(_cond, _local, _irqPath) NODE_LOCK_IF(_cond, _irqPath)
+
+#define NODE_UNLOCK_IF_HELD do {                         \
+    if(kernel_lock_is_self_in_queue()) {                 \
+        REMOTE_CALL_BATCH_FLUSH;                         \
+        NODE_UNLOCK;                                     \
+    }                                                    \
+} while(0)
+
+#define NODE_UNLOCK_FASTPATH NODE_UNLOCK
+#endif /* CONFIG_SMP_CORE_LOCAL_ENTRIES */
+
 #else
 #define NODE_LOCK(_irq) do {} while (0)
 #define NODE_UNLOCK do {} while (0)
 #define NODE_LOCK_IF(_cond, _irq) do {} while (0)
+#define NODE_LOCK_IF_NOT_CORE_LOCAL(_cond, _local, _irq) do {} while (0)
 #define NODE_UNLOCK_IF_HELD do {} while (0)
+#define NODE_UNLOCK_FASTPATH do {} while (0)
 #endif /* ENABLE_SMP_SUPPORT */
 
 #define NODE_LOCK_SYS NODE_LOCK(false)
 #define NODE_LOCK_IRQ NODE_LOCK(true)
 #define NODE_LOCK_SYS_IF(_cond) NODE_LOCK_IF(_cond, false)
 #define NODE_LOCK_IRQ_IF(_cond) NODE_LOCK_IF(_cond, true)
+#define NODE_LOCK_SYS_IF_NOT_CORE_LOCAL(_local) NODE_LOCK_IF_NOT_CORE_LOCAL(true, _local, false)
+#define NODE_LOCK_IRQ_IF_NOT_CORE_LOCAL(_cond, _local) NODE_LOCK_IF_NOT_CORE_LOCAL(_cond, _local, true)
 
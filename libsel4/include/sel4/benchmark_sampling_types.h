@@ -0,0 +1,45 @@
+/*
+ * Copyright 2020, Data61, CSIRO (ABN 41 687 119 230)
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <autoconf.h>
+#include <stdint.h>
+
+#ifdef CONFIG_BENCHMARK_SAMPLING
+#include <sel4/macros.h>
+
+#define seL4_BenchmarkSampleRingEntries LIBSEL4_BIT(CONFIG_BENCHMARK_SAMPLING_RING_BITS)
+
+/**
+ * @brief A sample of the thread that was running when the sampling period expired
+ *
+ * tcb identifies the thread for as long as it exists; it is the kernel address
+ * of its TCB. pc is its user-level program counter, or the idle thread's. The
+ * first depth entries of callers are the return addresses found by following
+ * the thread's frame pointers, innermost first. A walk stops at the first frame
+ * that is not mapped, so code built without frame pointers gives depth 0.
+ */
+typedef struct benchmark_sample {
+    seL4_Word tcb;
+    seL4_Word pc;
+    seL4_Word depth;
+    seL4_Word callers[CONFIG_BENCHMARK_SAMPLING_STACK_DEPTH];
+} benchmark_sample_t;
+
+/**
+ * @brief Per-core sample ring
+ *
+ * The log buffer holds one ring for each core, indexed by core, and is read
+ * the same way as a benchmark_track_ring_t: head is the number of samples
+ * taken so far, sample i is stored at samples[i % seL4_BenchmarkSampleRingEntries],
+ * and head is only advanced after the sample has been written.
+ */
+typedef struct benchmark_sample_ring {
+    seL4_Word head;
+    benchmark_sample_t samples[seL4_BenchmarkSampleRingEntries];
+} benchmark_sample_ring_t;
+#endif /* CONFIG_BENCHMARK_SAMPLING */
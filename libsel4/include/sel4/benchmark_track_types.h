@@ -61,4 +61,47 @@ typedef struct benchmark_syscall_log_entry {
     kernel_entry_t entry;
 } benchmark_track_kernel_entry_t;
 
+#ifdef CONFIG_BENCHMARK_TRACK_RING
+#include <sel4/macros.h>
+
+#define seL4_BenchmarkTrackRingEntries LIBSEL4_BIT(CONFIG_BENCHMARK_TRACK_RING_BITS)
+
+/**
+ * @brief Per-core kernel entry ring
+ *
+ * The log buffer holds one ring for each core, indexed by core. A core only
+ * writes to its own ring, overwriting the oldest entry once the ring is full.
+ * head is the number of entries written so far; entry i is stored at
+ * entries[i % seL4_BenchmarkTrackRingEntries], and head is only advanced
+ * after the entry has been written. A reader copies entries below head and then
+ * reads head again: an entry that is not above that second head minus
+ * seL4_BenchmarkTrackRingEntries may have been overwritten while it was read.
+ */
+typedef struct benchmark_track_ring {
+    seL4_Word head;
+    benchmark_track_kernel_entry_t entries[seL4_BenchmarkTrackRingEntries];
+} benchmark_track_ring_t;
+#endif /* CONFIG_BENCHMARK_TRACK_RING */
+
+#if CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0
+#define seL4_BenchmarkHistogramBuckets 32
+
+/**
+ * @brief Latency histogram of one kind of kernel entry
+ *
+ * Kernel entries are grouped by their complete kernel_entry_t, so syscalls are
+ * told apart by syscall number, cap type, invocation label and whether they
+ * took the fastpath. buckets[i] counts the entries that took between 2^i and
+ * 2^(i+1) - 1 cycles; entries shorter than two cycles are counted in buckets[0]
+ * and longer entries than the last bucket covers are counted in the last bucket.
+ * untracked is the number of entries since the histograms were last reset
+ * that were not counted because all histograms were in use.
+ */
+typedef struct benchmark_track_histogram {
+    kernel_entry_t entry;
+    seL4_Word untracked;
+    seL4_Word buckets[seL4_BenchmarkHistogramBuckets];
+} benchmark_track_histogram_t;
+#endif /* CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0 */
+
 #endif /* CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES || CONFIG_DEBUG_BUILD */
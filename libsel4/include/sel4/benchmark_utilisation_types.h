@@ -9,6 +9,24 @@
 #include <autoconf.h>
 
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+/* Hardware events counted for each thread. An event the PMU does not support,
+ * or has no counter left for, reads as 0. */
+enum benchmark_pmu_event {
+    /* Instructions retired */
+    BENCHMARK_PMU_INSTRUCTIONS,
+    /* Level 1 data cache refills */
+    BENCHMARK_PMU_L1D_MISSES,
+    /* Level 2 cache refills on ARM, last level cache misses on x86 */
+    BENCHMARK_PMU_L2_MISSES,
+    /* Mispredicted branches */
+    BENCHMARK_PMU_BRANCH_MISSES,
+    /* Level 1 data TLB refills on ARM, data TLB load misses that walk the page tables on x86 */
+    BENCHMARK_PMU_TLB_MISSES,
+    BENCHMARK_PMU_NUM_EVENTS
+};
+#endif /* CONFIG_BENCHMARK_UTILISATION_PMU */
+
 enum benchmark_track_util_ipc_index {
     /* TCB cap passed in the syscall */
     /* Number of cycles thread spends scheduled */
@@ -40,6 +58,15 @@ enum benchmark_track_util_ipc_index {
     BENCHMARK_TOTAL_KERNEL_UTILISATION,
     /* Total number of times the kernel is entered on the current core */
     BENCHMARK_TOTAL_NUMBER_KERNEL_ENTRIES,
+#ifdef CONFIG_SMP_BATCHED_REMOTE_CALLS
+    /* Total number of remote-call IPIs that batching has avoided, system wide */
+    BENCHMARK_TOTAL_REMOTE_CALL_IPIS_SAVED,
+#endif
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+    /* Hardware events counted while the requested thread ran, at user level or
+     * in the kernel, one for each benchmark_pmu_event */
+    BENCHMARK_TCB_PMU_EVENTS,
+#endif
 };
 
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
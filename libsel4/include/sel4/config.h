@@ -104,6 +104,7 @@
 
 /* Configurations requring the kernel log buffer */
 #if defined CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES || \
-    defined CONFIG_BENCHMARK_TRACEPOINTS
+    defined CONFIG_BENCHMARK_TRACEPOINTS || \
+    defined CONFIG_BENCHMARK_SAMPLING
 #define CONFIG_KERNEL_LOG_BUFFER
 #endif
@@ -59,6 +59,31 @@ enum {
 };
 #define seL4_MsgMaxExtraCaps (LIBSEL4_BIT(seL4_MsgExtraCapBits)-1)
 
+#ifdef CONFIG_BATCHED_IPC
+/* Layout of each seL4_BatchSend descriptor in the message words. */
+enum seL4_BatchSendDescriptor {
+    seL4_BatchSend_CPtr = 0,
+    seL4_BatchSend_MessageInfo,
+    seL4_BatchSend_Offset,
+    seL4_BatchSend_DescriptorWords
+};
+#endif
+
+#ifdef CONFIG_UNTYPED_RETYPE_BATCH
+/* Layout of each seL4_Untyped_RetypeBatch descriptor in the message words. */
+enum seL4_UntypedRetypeBatchDescriptor {
+    seL4_UntypedRetypeBatch_Type = 0,
+    seL4_UntypedRetypeBatch_SizeBits,
+    seL4_UntypedRetypeBatch_NodeOffset,
+    seL4_UntypedRetypeBatch_NumObjects,
+    seL4_UntypedRetypeBatch_DescriptorWords
+};
+
+/* Message word at which the first descriptor starts. */
+#define seL4_UntypedRetypeBatch_FirstDescriptor 3
+#define seL4_UntypedRetypeBatchMaxDescs 8
+#endif
+
 /* seL4_CapRights_t defined in shared_types_*.bf */
 #define seL4_CapRightsBits 4
 
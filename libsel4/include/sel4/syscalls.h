@@ -306,6 +306,32 @@ seL4_BenchmarkResetAllThreadsUtilisation(void);
 
 #endif
 #endif
+
+#if CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0
+/**
+ * @xmlonly <manual name="Get Entry Histogram" label="sel4_benchmarkgetentryhistogram"/> @endxmlonly
+ * @brief Get a kernel entry latency histogram.
+ *
+ * Each core keeps CONFIG_BENCHMARK_TRACK_HISTOGRAMS latency histograms, each for one kind of
+ * kernel entry. If the requested histogram is in use, it is written into the caller's IPC buffer
+ * as a `benchmark_track_histogram_t`, with the counts of all cores for the same kind of entry
+ * added in. Such a histogram is only returned at the lowest index it is found at.
+ *
+ * @param[in] index Index of the histogram, less than CONFIG_BENCHMARK_TRACK_HISTOGRAMS times
+ *                  CONFIG_MAX_NUM_NODES.
+ * @return The number of kernel entries counted in the histogram, 0 if it is not in use.
+ */
+LIBSEL4_INLINE_FUNC seL4_Word
+seL4_BenchmarkGetEntryHistogram(seL4_Word index);
+
+/**
+ * @xmlonly <manual name="Reset Entry Histograms" label="sel4_benchmarkresetentryhistograms"/> @endxmlonly
+ * @brief Clear all kernel entry latency histograms.
+ *
+ */
+LIBSEL4_INLINE_FUNC void
+seL4_BenchmarkResetEntryHistograms(void);
+#endif
 #endif
 /** @} */
 
@@ -390,3 +416,25 @@ LIBSEL4_INLINE_FUNC void
 seL4_SetTLSBase(seL4_Word tls_base);
 #endif
 
+#ifdef CONFIG_BATCHED_IPC
+/**
+ * @xmlonly <manual name="BatchSend" label="sel4_batchsend"/> @endxmlonly
+ * @brief Perform several non-blocking sends in one system call.
+ *
+ * The message words of the IPC buffer hold `count` descriptors, each of
+ * `seL4_BatchSend_DescriptorWords` words, starting at message register 0.
+ * Each descriptor gives a capability (`seL4_BatchSend_CPtr`), the message
+ * info for the message (`seL4_BatchSend_MessageInfo`) and the message register
+ * at which that message's words start (`seL4_BatchSend_Offset`).
+ *
+ * An endpoint is sent to only if a thread is already waiting on it, and a
+ * notification is signalled. Caps cannot be transferred. The sends are
+ * performed in order and stop at the first one that is invalid or would block.
+ *
+ * @param count The number of descriptors.
+ * @return The number of sends that were performed.
+ */
+LIBSEL4_INLINE_FUNC seL4_Word
+seL4_BatchSend(seL4_Word count);
+#endif
+
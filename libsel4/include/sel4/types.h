@@ -43,6 +43,21 @@ typedef seL4_CPtr seL4_SchedControl;
 
 typedef seL4_Uint64 seL4_Time;
 
+#ifdef CONFIG_UNTYPED_RETYPE_BATCH
+/* One group of objects for seL4_Untyped_RetypeBatch, laid out as described
+ * by seL4_UntypedRetypeBatchDescriptor. Unused descriptors are ignored. */
+typedef struct seL4_UntypedRetypeDesc {
+    seL4_Word type;
+    seL4_Word size_bits;
+    seL4_Word node_offset;
+    seL4_Word num_objects;
+} seL4_UntypedRetypeDesc;
+
+typedef struct seL4_UntypedRetypeDescs {
+    seL4_UntypedRetypeDesc descs[seL4_UntypedRetypeBatchMaxDescs];
+} seL4_UntypedRetypeDescs;
+#endif
+
 #define seL4_NilData 0
 
 #include <sel4/arch/constants.h>
@@ -1007,6 +1007,32 @@ LIBSEL4_INLINE_FUNC seL4_Word seL4_BenchmarkResetAllThreadsUtilisation(void)
 
 #endif /* CONFIG_DEBUG_BUILD */
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
+
+#if CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0
+LIBSEL4_INLINE_FUNC seL4_Word seL4_BenchmarkGetEntryHistogram(seL4_Word index)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    LIBSEL4_UNUSED seL4_Word unused2 = 0;
+    seL4_Word count_ret;
+
+    x86_sys_send_recv(seL4_SysBenchmarkGetEntryHistogram, index, &count_ret, 0, &unused0, &unused1,
+                      MCS_COND(0, &unused2));
+
+    return count_ret;
+}
+
+LIBSEL4_INLINE_FUNC void seL4_BenchmarkResetEntryHistograms(void)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    seL4_Word unused2 = 0;
+    LIBSEL4_UNUSED seL4_Word unused3 = 0;
+
+    x86_sys_send_recv(seL4_SysBenchmarkResetEntryHistograms, 0, &unused0, 0, &unused1, &unused2,
+                      MCS_COND(0, &unused3));
+}
+#endif /* CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0 */
 #endif /* CONFIG_ENABLE_BENCHMARKS */
 
 #ifdef CONFIG_SET_TLS_BASE_SELF
@@ -1016,3 +1042,15 @@ LIBSEL4_INLINE_FUNC void seL4_SetTLSBase(seL4_Word tls_base)
     asm volatile("" ::: "memory");
 }
 #endif /* CONFIG_SET_TLS_BASE_SELF */
+
+#ifdef CONFIG_BATCHED_IPC
+LIBSEL4_INLINE_FUNC seL4_Word seL4_BatchSend(seL4_Word count)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    LIBSEL4_UNUSED seL4_Word unused2 = 0;
+
+    x86_sys_send_recv(seL4_SysBatchSend, count, &count, 0, &unused0, &unused1, MCS_COND(0, &unused2));
+    return count;
+}
+#endif /* CONFIG_BATCHED_IPC */
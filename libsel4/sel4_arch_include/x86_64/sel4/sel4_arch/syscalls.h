@@ -794,6 +794,36 @@ LIBSEL4_INLINE_FUNC void seL4_BenchmarkResetAllThreadsUtilisation(void)
 
 #endif
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
+
+#if CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0
+LIBSEL4_INLINE_FUNC seL4_Word seL4_BenchmarkGetEntryHistogram(seL4_Word index)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    seL4_Word unused2 = 0;
+    seL4_Word unused3 = 0;
+    seL4_Word unused4 = 0;
+
+    seL4_Word count_ret;
+    x64_sys_send_recv(seL4_SysBenchmarkGetEntryHistogram, index, &count_ret, 0, &unused0, &unused1, &unused2, &unused3,
+                      &unused4, 0);
+
+    return count_ret;
+}
+
+LIBSEL4_INLINE_FUNC void seL4_BenchmarkResetEntryHistograms(void)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    seL4_Word unused2 = 0;
+    seL4_Word unused3 = 0;
+    seL4_Word unused4 = 0;
+    seL4_Word unused5 = 0;
+
+    x64_sys_send_recv(seL4_SysBenchmarkResetEntryHistograms, 0, &unused0, 0, &unused1, &unused2, &unused3, &unused4,
+                      &unused5, 0);
+}
+#endif /* CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0 */
 #endif /* CONFIG_ENABLE_BENCHMARKS */
 
 #ifdef CONFIG_SET_TLS_BASE_SELF
@@ -804,3 +834,17 @@ LIBSEL4_INLINE_FUNC void seL4_SetTLSBase(seL4_Word tls_base)
 }
 #endif /* CONFIG_SET_TLS_BASE_SELF */
 
+#ifdef CONFIG_BATCHED_IPC
+LIBSEL4_INLINE_FUNC seL4_Word seL4_BatchSend(seL4_Word count)
+{
+    seL4_Word unused0 = 0;
+    seL4_Word unused1 = 0;
+    seL4_Word unused2 = 0;
+    seL4_Word unused3 = 0;
+    seL4_Word unused4 = 0;
+
+    x64_sys_send_recv(seL4_SysBatchSend, count, &count, 0, &unused0, &unused1, &unused2, &unused3, &unused4, 0);
+    return count;
+}
+#endif /* CONFIG_BATCHED_IPC */
+
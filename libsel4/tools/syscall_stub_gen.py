@@ -243,6 +243,7 @@ def init_data_types(wordsize):
 
         # seL4 Structures
         BitFieldType("seL4_CapRights_t", wordsize, wordsize),
+        StructType("seL4_UntypedRetypeDescs", wordsize * 32, wordsize),
 
         # Object types
         CapType("seL4_CPtr", wordsize),
@@ -10,6 +10,7 @@
 #include <arch/benchmark.h>
 #include <benchmark/benchmark_track.h>
 #include <benchmark/benchmark_utilisation.h>
+#include <benchmark/benchmark_sampling.h>
 #include <api/syscall.h>
 #include <api/failures.h>
 #include <api/faults.h>
@@ -21,6 +22,7 @@
 #include <plat/machine/hardware.h>
 #include <object/interrupt.h>
 #include <model/statedata.h>
+#include <model/preemption.h>
 #include <string.h>
 #include <kernel/traps.h>
 #include <arch/machine.h>
@@ -38,7 +40,7 @@ exception_t handleInterruptEntry(void)
 
     irq = getActiveIRQ();
 #ifdef CONFIG_KERNEL_MCS
-    if (SMP_TERNARY(clh_is_self_in_queue(), 1)) {
+    if (SMP_TERNARY(kernel_lock_is_self_in_queue(), 1)) {
         updateTimestamp();
         checkBudget();
     }
@@ -55,7 +57,7 @@ exception_t handleInterruptEntry(void)
     }
 
 #ifdef CONFIG_KERNEL_MCS
-    if (SMP_TERNARY(clh_is_self_in_queue(), 1)) {
+    if (SMP_TERNARY(kernel_lock_is_self_in_queue(), 1)) {
 #endif
         schedule();
         activateThread();
@@ -66,6 +68,67 @@ exception_t handleInterruptEntry(void)
     return EXCEPTION_NONE;
 }
 
+#ifdef CONFIG_BATCHED_IPC
+/* Perform the sends described by the descriptors in the caller's IPC
+ * buffer, stopping at the first that cannot complete without blocking.
+ * Each descriptor gives a cap, a message info and the offset of the message
+ * words within the IPC buffer. The number completed is returned in
+ * capRegister. */
+static void handleBatchSend(void)
+{
+    tcb_t *thread;
+    word_t *buffer;
+    word_t count, done;
+
+    thread = NODE_STATE(ksCurThread);
+    count = getRegister(thread, capRegister);
+    buffer = lookupIPCBuffer(false, thread);
+
+    done = 0;
+    if (buffer && count <= seL4_MsgMaxLength / seL4_BatchSend_DescriptorWords) {
+        for (; done < count; done++) {
+            word_t *desc = &buffer[1 + done * seL4_BatchSend_DescriptorWords];
+            cptr_t cptr = desc[seL4_BatchSend_CPtr];
+            seL4_MessageInfo_t info = messageInfoFromWord(desc[seL4_BatchSend_MessageInfo]);
+            word_t offset = desc[seL4_BatchSend_Offset];
+            word_t length = seL4_MessageInfo_get_length(info);
+            lookupCap_ret_t lu_ret;
+
+            if (unlikely(seL4_MessageInfo_get_extraCaps(info) != 0 ||
+                         offset > seL4_MsgMaxLength || length > seL4_MsgMaxLength - offset)) {
+                userError("BatchSend: invalid descriptor %lu.", done);
+                break;
+            }
+
+            lu_ret = lookupCap(thread, cptr);
+            if (unlikely(lu_ret.status != EXCEPTION_NONE)) {
+                userError("BatchSend: invalid cap #%lu.", cptr);
+                break;
+            }
+
+            if (cap_get_capType(lu_ret.cap) == cap_endpoint_cap &&
+                cap_endpoint_cap_get_capCanSend(lu_ret.cap)) {
+                if (!sendBatchedIPC(cap_endpoint_cap_get_capEPBadge(lu_ret.cap), info,
+                                    &buffer[1 + offset],
+                                    EP_PTR(cap_endpoint_cap_get_capEPPtr(lu_ret.cap)))) {
+                    /* the send would block */
+                    break;
+                }
+            } else if (cap_get_capType(lu_ret.cap) == cap_notification_cap &&
+                       cap_notification_cap_get_capNtfnCanSend(lu_ret.cap)) {
+                sendSignal(NTFN_PTR(cap_notification_cap_get_capNtfnPtr(lu_ret.cap)),
+                           cap_notification_cap_get_capNtfnBadge(lu_ret.cap));
+            } else {
+                userError("BatchSend: cap #%lu cannot be sent to.", cptr);
+                break;
+            }
+        }
+    }
+
+    setRegister(thread, capRegister, done);
+}
+#endif /* CONFIG_BATCHED_IPC */
+
 exception_t handleUnknownSyscall(word_t w)
 {
 #ifdef CONFIG_PRINTING
@@ -208,18 +271,27 @@ exception_t handleUnknownSyscall(word_t w)
         }
 
         ksLogIndex = 0;
+#ifdef CONFIG_BENCHMARK_TRACK_RING
+        benchmark_track_ring_reset();
+#endif
+#ifdef CONFIG_BENCHMARK_SAMPLING
+        benchmark_sampling_reset();
+#endif
 #endif /* CONFIG_KERNEL_LOG_BUFFER */
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
         NODE_STATE(benchmark_log_utilisation_enabled) = true;
         benchmark_track_reset_utilisation(NODE_STATE(ksIdleThread));
-        NODE_STATE(ksCurThread)->benchmark.schedule_start_time = ksEnter;
+        NODE_STATE(ksCurThread)->benchmark.schedule_start_time = NODE_STATE(ksEnter);
         NODE_STATE(ksCurThread)->benchmark.number_schedules++;
 
-        NODE_STATE(benchmark_start_time) = ksEnter;
+        NODE_STATE(benchmark_start_time) = NODE_STATE(ksEnter);
         NODE_STATE(benchmark_kernel_time) = 0;
         NODE_STATE(benchmark_kernel_number_entries) = 0;
         NODE_STATE(benchmark_kernel_number_schedules) = 1;
         benchmark_arch_utilisation_reset();
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+        benchmark_utilisation_pmu_start();
+#endif
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
         setRegister(NODE_STATE(ksCurThread), capRegister, seL4_NoError);
         return EXCEPTION_NONE;
@@ -240,6 +312,13 @@ exception_t handleUnknownSyscall(word_t w)
             setRegister(NODE_STATE(ksCurThread), capRegister, seL4_IllegalOperation);
             return EXCEPTION_SYSCALL_ERROR;
         }
+#ifdef CONFIG_BENCHMARK_TRACK_RING
+        /* the rings start out empty, whatever the frame contained */
+        benchmark_track_ring_reset();
+#endif
+#ifdef CONFIG_BENCHMARK_SAMPLING
+        benchmark_sampling_reset();
+#endif
 
         setRegister(NODE_STATE(ksCurThread), capRegister, seL4_NoError);
         return EXCEPTION_NONE;
@@ -276,6 +355,9 @@ exception_t handleUnknownSyscall(word_t w)
         printf("  \"BENCHMARK_TOTAL_KERNEL_UTILISATION\":%lu,\n", (word_t) NODE_STATE(benchmark_kernel_time));
         printf("  \"BENCHMARK_TOTAL_NUMBER_KERNEL_ENTRIES\":%lu,\n", (word_t) NODE_STATE(benchmark_kernel_number_entries));
         printf("  \"BENCHMARK_TOTAL_NUMBER_SCHEDULES\":%lu,\n", (word_t) NODE_STATE(benchmark_kernel_number_schedules));
+#ifdef CONFIG_SMP_BATCHED_REMOTE_CALLS
+        printf("  \"BENCHMARK_TOTAL_REMOTE_CALL_IPIS_SAVED\":%lu,\n", remoteCallIPIsSaved);
+#endif
         printf("  \"BENCHMARK_TCB_\": [\n");
         for (tcb_t *curr = NODE_STATE(ksDebugTCBs); curr != NULL; curr = TCB_PTR_DEBUG_PTR(curr)->tcbDebugNext) {
             printf("    {\n");
@@ -302,6 +384,25 @@ exception_t handleUnknownSyscall(word_t w)
 #endif /* CONFIG_DEBUG_BUILD */
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
 
+#if CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0
+    else if (w == SysBenchmarkGetEntryHistogram) {
+        word_t index = getRegister(NODE_STATE(ksCurThread), capRegister);
+        seL4_IPCBuffer *buffer = (seL4_IPCBuffer *)lookupIPCBuffer(true, NODE_STATE(ksCurThread));
+        word_t count = 0;
+
+        if (buffer != NULL) {
+            count = benchmark_track_histogram_get(index, (benchmark_track_histogram_t *)&buffer->msg[0]);
+        } else {
+            userError("SysBenchmarkGetEntryHistogram: no IPC buffer to return the histogram in");
+        }
+        setRegister(NODE_STATE(ksCurThread), capRegister, count);
+        return EXCEPTION_NONE;
+    } else if (w == SysBenchmarkResetEntryHistograms) {
+        benchmark_track_histograms_reset();
+        return EXCEPTION_NONE;
+    }
+#endif /* CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0 */
+
     else if (w == SysBenchmarkNullSyscall) {
         return EXCEPTION_NONE;
     }
@@ -320,8 +421,16 @@ exception_t handleUnknownSyscall(word_t w)
             return Arch_setTLSRegister(tls_base);
         }
 #endif
-        current_fault = seL4_Fault_UnknownSyscall_new(w);
-        handleFault(NODE_STATE(ksCurThread));
+#ifdef CONFIG_BATCHED_IPC
+        if (w == SysBatchSend)
+        {
+            handleBatchSend();
+        } else
+#endif
+        {
+            current_fault = seL4_Fault_UnknownSyscall_new(w);
+            handleFault(NODE_STATE(ksCurThread));
+        }
     })
 
     schedule();
@@ -410,6 +519,9 @@ static exception_t handleInvocation(bool_t isCall, bool_t isBlocking)
     if (unlikely(length > n_msgRegisters && !buffer)) {
         length = n_msgRegisters;
     }
+#ifdef CONFIG_PREEMPTION_BUDGET
+    preemptionBudgetStart();
+#endif
 #ifdef CONFIG_KERNEL_MCS
     status = decodeInvocation(seL4_MessageInfo_get_label(info), length,
                               cptr, lu_ret.slot, lu_ret.cap,
@@ -573,6 +685,45 @@ static void handleRecv(bool_t isBlocking)
     }
 }
 
+#ifdef CONFIG_SMP_CORE_LOCAL_ENTRIES
+/* Check, only reading shared state, whether an NBRecv by thread would do no
+ * more than doNBRecvFailedTransfer. Anything else, including the faults for
+ * a bad cap, is left to handleRecv. */
+static bool_t nbRecvIsEmpty(tcb_t *thread)
+{
+    cap_t cap;
+    notification_t *ntfnPtr;
+    tcb_t *boundTCB;
+
+    cap = lookup_fp(TCB_PTR_CTE_PTR(thread, tcbCTable)->cap, getRegister(thread, capRegister));
+
+    switch (cap_get_capType(cap)) {
+    case cap_endpoint_cap:
+        /* handleRecv deletes the caller cap before receiving */
+        if (!cap_endpoint_cap_get_capCanReceive(cap) ||
+            cap_get_capType(TCB_PTR_CTE_PTR(thread, tcbCaller)->cap) != cap_null_cap) {
+            return false;
+        }
+        ntfnPtr = thread->tcbBoundNotification;
+        if (ntfnPtr && notification_ptr_get_state(ntfnPtr) == NtfnState_Active) {
+            return false;
+        }
+        return endpoint_ptr_get_state(EP_PTR(cap_endpoint_cap_get_capEPPtr(cap))) != EPState_Send;
+
+    case cap_notification_cap:
+        ntfnPtr = NTFN_PTR(cap_notification_cap_get_capNtfnPtr(cap));
+        boundTCB = (tcb_t *)notification_ptr_get_ntfnBoundTCB(ntfnPtr);
+        if (!cap_notification_cap_get_capNtfnCanReceive(cap) || (boundTCB && boundTCB != thread)) {
+            return false;
+        }
+        return notification_ptr_get_state(ntfnPtr) != NtfnState_Active;
+
+    default:
+        return false;
+    }
+}
+#endif /* CONFIG_SMP_CORE_LOCAL_ENTRIES */
+
 #ifdef CONFIG_KERNEL_MCS
 static inline void mcsPreemptionPoint(irq_t irq)
 {
@@ -618,6 +769,15 @@ exception_t handleSyscall(syscall_t syscall)
 {
     exception_t ret;
     irq_t irq;
+
+#ifdef CONFIG_SMP_CORE_LOCAL_ENTRIES
+    if (isCoreLocalFastpathSyscall(syscall) && !kernel_lock_is_self_in_queue()) {
+        /* The fastpath has not changed anything, so start again under the lock */
+        core_local_exit(getCurrentCPUIndex());
+        NODE_LOCK_SYS;
+    }
+#endif
+
     MCS_DO_IF_BUDGET({
         switch (syscall)
         {
@@ -719,6 +879,17 @@ exception_t handleSyscall(syscall_t syscall)
             break;
 #endif
         case SysNBRecv:
+#ifdef CONFIG_SMP_CORE_LOCAL_ENTRIES
+            if (!kernel_lock_is_self_in_queue()) {
+                if (likely(nbRecvIsEmpty(NODE_STATE(ksCurThread)))) {
+                    doNBRecvFailedTransfer(NODE_STATE(ksCurThread));
+                    break;
+                }
+                /* Nothing has been changed yet, so start again under the lock */
+                core_local_exit(getCurrentCPUIndex());
+                NODE_LOCK_SYS;
+            }
+#endif
             handleRecv(false, true);
             break;
 
@@ -2828,7 +2828,7 @@ void kernelDataAbort(word_t pc)
 
 #endif
 
-#ifdef CONFIG_PRINTING
+#if defined(CONFIG_PRINTING) || defined(CONFIG_BENCHMARK_SAMPLING)
 typedef struct readWordFromVSpace_ret {
     exception_t status;
     word_t value;
@@ -2872,6 +2872,11 @@ static readWordFromVSpace_ret_t readWordFromVSpace(pde_t *pd, word_t vaddr)
         }
     }
 
+    /* device frames outside the kernel window cannot be read */
+    if (paddr < PADDR_BASE || paddr >= PADDR_TOP) {
+        ret.status = EXCEPTION_LOOKUP_FAULT;
+        return ret;
+    }
 
     kernel_vaddr = (word_t)paddr_to_pptr(paddr);
     value = (word_t *)(kernel_vaddr + offset);
@@ -2880,6 +2885,45 @@ static readWordFromVSpace_ret_t readWordFromVSpace(pde_t *pd, word_t vaddr)
     return ret;
 }
 
+#ifdef CONFIG_BENCHMARK_SAMPLING
+word_t Arch_userCallStack(tcb_t *tptr, word_t *callers, word_t max)
+{
+    cap_t threadRoot;
+    pde_t *pd;
+    word_t fp;
+    word_t depth = 0;
+
+    threadRoot = TCB_PTR_CTE_PTR(tptr, tcbVTable)->cap;
+    if (cap_get_capType(threadRoot) != cap_page_directory_cap) {
+        return 0;
+    }
+
+    pd = (pde_t *)pptr_of_cap(threadRoot);
+    fp = getRegister(tptr, R11);
+
+    /* GCC's ARM state frames keep the return address at the frame pointer
+     * and the caller's frame pointer just below it. */
+    while (depth < max && fp != 0 && IS_ALIGNED(fp, seL4_WordSizeBits)) {
+        readWordFromVSpace_ret_t lr = readWordFromVSpace(pd, fp);
+        readWordFromVSpace_ret_t next = readWordFromVSpace(pd, fp - sizeof(word_t));
+
+        if (next.status != EXCEPTION_NONE || lr.status != EXCEPTION_NONE) {
+            break;
+        }
+        callers[depth] = lr.value;
+        depth++;
+        /* the stack grows down, so a caller's frame is always above */
+        if (next.value <= fp) {
+            break;
+        }
+        fp = next.value;
+    }
+
+    return depth;
+}
+#endif /* CONFIG_BENCHMARK_SAMPLING */
+
+#ifdef CONFIG_PRINTING
 void Arch_userStackTrace(tcb_t *tptr)
 {
     cap_t threadRoot;
@@ -2916,5 +2960,6 @@ void Arch_userStackTrace(tcb_t *tptr)
         }
     }
 }
-#endif
+#endif /* CONFIG_PRINTING */
+#endif /* CONFIG_PRINTING || CONFIG_BENCHMARK_SAMPLING */
 
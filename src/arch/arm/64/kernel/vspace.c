@@ -2442,7 +2442,7 @@ void kernelDataAbort(word_t pc)
 }
 #endif /* CONFIG_DEBUG_BUILD */
 
-#ifdef CONFIG_PRINTING
+#if defined(CONFIG_PRINTING) || defined(CONFIG_BENCHMARK_SAMPLING)
 typedef struct readWordFromVSpace_ret {
     exception_t status;
     word_t value;
@@ -2458,7 +2458,8 @@ static readWordFromVSpace_ret_t readWordFromVSpace(vspace_root_t *pd, word_t vad
 
     lookup_frame_ret = lookupFrame(pd, vaddr);
 
-    if (!lookup_frame_ret.valid) {
+    /* device frames outside the kernel window cannot be read */
+    if (!lookup_frame_ret.valid || lookup_frame_ret.frameBase >= PADDR_TOP) {
         ret.status = EXCEPTION_LOOKUP_FAULT;
         return ret;
     }
@@ -2472,6 +2473,45 @@ static readWordFromVSpace_ret_t readWordFromVSpace(vspace_root_t *pd, word_t vad
     return ret;
 }
 
+#ifdef CONFIG_BENCHMARK_SAMPLING
+word_t Arch_userCallStack(tcb_t *tptr, word_t *callers, word_t max)
+{
+    cap_t threadRoot;
+    vspace_root_t *vspaceRoot;
+    word_t fp;
+    word_t depth = 0;
+
+    threadRoot = TCB_PTR_CTE_PTR(tptr, tcbVTable)->cap;
+    if (cap_get_capType(threadRoot) != cap_vtable_root_cap) {
+        return 0;
+    }
+
+    vspaceRoot = cap_vtable_root_get_basePtr(threadRoot);
+    fp = getRegister(tptr, X29);
+
+    /* A frame record is the caller's frame pointer followed by the return
+     * address, and is 16 byte aligned, so both words are on the same page. */
+    while (depth < max && fp != 0 && IS_ALIGNED(fp, seL4_WordSizeBits + 1)) {
+        readWordFromVSpace_ret_t next = readWordFromVSpace(vspaceRoot, fp);
+        readWordFromVSpace_ret_t lr = readWordFromVSpace(vspaceRoot, fp + sizeof(word_t));
+
+        if (next.status != EXCEPTION_NONE || lr.status != EXCEPTION_NONE) {
+            break;
+        }
+        callers[depth] = lr.value;
+        depth++;
+        /* the stack grows down, so a caller's frame is always above */
+        if (next.value <= fp) {
+            break;
+        }
+        fp = next.value;
+    }
+
+    return depth;
+}
+#endif /* CONFIG_BENCHMARK_SAMPLING */
+
+#ifdef CONFIG_PRINTING
 void Arch_userStackTrace(tcb_t *tptr)
 {
     cap_t threadRoot;
@@ -2509,6 +2549,7 @@ void Arch_userStackTrace(tcb_t *tptr)
     }
 }
 #endif /* CONFIG_PRINTING */
+#endif /* CONFIG_PRINTING || CONFIG_BENCHMARK_SAMPLING */
 
 #if defined(CONFIG_KERNEL_LOG_BUFFER)
 exception_t benchmark_arch_map_logBuffer(word_t frame_cptr)
@@ -97,6 +97,11 @@ compile_assert(log_pde_is_correct_preallocated_pde,
                GET_PD_INDEX(KS_LOG_PPTR) == BIT(PD_INDEX_BITS) - 2);
 #endif
 
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+/* Size in bits of the block zeroed by DC ZVA, or 0 if it may not be used */
+word_t armKSdczvaBlockBits;
+#endif
+
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
 UP_STATE_DEFINE(vcpu_t, *armHSCurVCPU);
 UP_STATE_DEFINE(bool_t, armHSVCPUActive);
@@ -19,6 +19,82 @@ seL4_Word ksLogIndexFinalized = 0;
 UP_STATE_DEFINE(uint64_t, ccnt_num_overflows);
 #endif /* CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT */
 
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+word_t benchmark_pmu_num_counters;
+
+/* Common event numbers of ARMv7 and ARMv8 PMUs */
+static const word_t pmu_events[BENCHMARK_PMU_NUM_EVENTS] = {
+    [BENCHMARK_PMU_INSTRUCTIONS] = 0x08,  /* INST_RETIRED */
+    [BENCHMARK_PMU_L1D_MISSES] = 0x03,    /* L1D_CACHE_REFILL */
+    [BENCHMARK_PMU_L2_MISSES] = 0x17,     /* L2D_CACHE_REFILL */
+    [BENCHMARK_PMU_BRANCH_MISSES] = 0x10, /* BR_MIS_PRED */
+    [BENCHMARK_PMU_TLB_MISSES] = 0x05,    /* L1D_TLB_REFILL */
+};
+
+static void arm_init_pmu_events(void)
+{
+    word_t pmcr;
+    word_t num_counters;
+    word_t enable = 0;
+
+    SYSTEM_READ_WORD(PMCR, pmcr);
+    num_counters = (pmcr >> PMCR_NUM_COUNTERS) & MASK(5);
+#ifdef CONFIG_BENCHMARK_SAMPLING
+    /* the last counter is used for sampling */
+    if (num_counters > 0) {
+        num_counters--;
+    }
+#endif
+    benchmark_pmu_num_counters = MIN(num_counters, BENCHMARK_PMU_NUM_EVENTS);
+
+    for (word_t i = 0; i < benchmark_pmu_num_counters; i++) {
+        word_t type = pmu_events[i];
+        if (config_set(CONFIG_ARM_HYPERVISOR_SUPPORT)) {
+            type |= BIT(PMXEVTYPER_NSH);
+        }
+        SYSTEM_WRITE_WORD(PMSELR, i);
+        isb();
+        SYSTEM_WRITE_WORD(PMXEVTYPER, type);
+        enable |= BIT(i);
+    }
+
+    SYSTEM_WRITE_WORD(PMCNTENSET, enable);
+}
+#endif /* CONFIG_BENCHMARK_UTILISATION_PMU */
+
+#ifdef CONFIG_BENCHMARK_SAMPLING
+compile_assert(benchmark_sampling_period_fits_counter,
+               CONFIG_BENCHMARK_SAMPLING_PERIOD > 0 && CONFIG_BENCHMARK_SAMPLING_PERIOD <= UINT32_MAX)
+
+word_t benchmark_sample_counter;
+
+static void arm_init_sampling(void)
+{
+    word_t pmcr;
+    word_t num_counters;
+    word_t type = 0x11; /* CPU_CYCLES */
+
+    SYSTEM_READ_WORD(PMCR, pmcr);
+    num_counters = (pmcr >> PMCR_NUM_COUNTERS) & MASK(5);
+    if (num_counters == 0) {
+        printf("No PMU event counter for sampling, no samples will be taken\n");
+        return;
+    }
+    benchmark_sample_counter = num_counters - 1;
+
+    if (config_set(CONFIG_ARM_HYPERVISOR_SUPPORT)) {
+        type |= BIT(PMXEVTYPER_NSH);
+    }
+    SYSTEM_WRITE_WORD(PMSELR, benchmark_sample_counter);
+    isb();
+    SYSTEM_WRITE_WORD(PMXEVTYPER, type);
+    benchmark_arch_sampling_rearm();
+
+    SYSTEM_WRITE_WORD(PMINTENSET, BIT(benchmark_sample_counter));
+    SYSTEM_WRITE_WORD(PMCNTENSET, BIT(benchmark_sample_counter));
+}
+#endif /* CONFIG_BENCHMARK_SAMPLING */
+
 #ifdef CONFIG_ENABLE_BENCHMARKS
 void arm_init_ccnt(void)
 {
@@ -34,5 +110,12 @@ void arm_init_ccnt(void)
 #ifdef CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT
     armv_enableOverflowIRQ();
 #endif /* CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT */
+
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+    arm_init_pmu_events();
+#endif
+#ifdef CONFIG_BENCHMARK_SAMPLING
+    arm_init_sampling();
+#endif
 }
 #endif
@@ -22,8 +22,8 @@ void VISIBLE NORETURN c_handle_undefined_instruction(void)
     c_entry_hook();
 
 #ifdef TRACK_KERNEL_ENTRIES
-    ksKernelEntry.path = Entry_UserLevelFault;
-    ksKernelEntry.word = getRegister(NODE_STATE(ksCurThread), NextIP);
+    NODE_STATE(ksKernelEntry).path = Entry_UserLevelFault;
+    NODE_STATE(ksKernelEntry).word = getRegister(NODE_STATE(ksCurThread), NextIP);
 #endif
 
 #if defined(CONFIG_HAVE_FPU) && defined(CONFIG_ARCH_AARCH32)
@@ -68,8 +68,8 @@ static inline void NORETURN c_handle_vm_fault(vm_fault_type_t type)
     c_entry_hook();
 
 #ifdef TRACK_KERNEL_ENTRIES
-    ksKernelEntry.path = Entry_VMFault;
-    ksKernelEntry.word = getRegister(NODE_STATE(ksCurThread), NextIP);
+    NODE_STATE(ksKernelEntry).path = Entry_VMFault;
+    NODE_STATE(ksKernelEntry).word = getRegister(NODE_STATE(ksCurThread), NextIP);
 #endif
 
     handleVMFaultEvent(type);
@@ -89,14 +89,15 @@ void VISIBLE NORETURN c_handle_instruction_fault(void)
 
 void VISIBLE NORETURN c_handle_interrupt(void)
 {
-    NODE_LOCK_IRQ_IF(IRQT_TO_IRQ(getActiveIRQ()) != irq_remote_call_ipi);
+    NODE_LOCK_IRQ_IF_NOT_CORE_LOCAL(IRQT_TO_IRQ(getActiveIRQ()) != irq_remote_call_ipi,
+                                    IRQT_TO_IRQ(getActiveIRQ()) == KERNEL_TIMER_IRQ);
     c_entry_hook();
 
 #ifdef TRACK_KERNEL_ENTRIES
-    ksKernelEntry.path = Entry_Interrupt;
-    ksKernelEntry.word = IRQT_TO_IRQ(getActiveIRQ());
+    NODE_STATE(ksKernelEntry).path = Entry_Interrupt;
+    NODE_STATE(ksKernelEntry).word = IRQT_TO_IRQ(getActiveIRQ());
 #ifdef ENABLE_SMP_SUPPORT
-    ksKernelEntry.core = getCurrentCPUIndex();
+    NODE_STATE(ksKernelEntry).core = getCurrentCPUIndex();
 #endif
 #endif
 
@@ -108,13 +109,13 @@ void NORETURN slowpath(syscall_t syscall)
 {
     if (unlikely(syscall < SYSCALL_MIN || syscall > SYSCALL_MAX)) {
 #ifdef TRACK_KERNEL_ENTRIES
-        ksKernelEntry.path = Entry_UnknownSyscall;
+        NODE_STATE(ksKernelEntry).path = Entry_UnknownSyscall;
         /* ksKernelEntry.word word is already set to syscall */
 #endif /* TRACK_KERNEL_ENTRIES */
         handleUnknownSyscall(syscall);
     } else {
 #ifdef TRACK_KERNEL_ENTRIES
-        ksKernelEntry.is_fastpath = 0;
+        NODE_STATE(ksKernelEntry).is_fastpath = 0;
 #endif /* TRACK KERNEL ENTRIES */
         handleSyscall(syscall);
     }
@@ -125,12 +126,12 @@ void NORETURN slowpath(syscall_t syscall)
 
 void VISIBLE c_handle_syscall(word_t cptr, word_t msgInfo, syscall_t syscall)
 {
-    NODE_LOCK_SYS;
+    NODE_LOCK_SYS_IF_NOT_CORE_LOCAL(isCoreLocalSyscall(syscall));
 
     c_entry_hook();
 #ifdef TRACK_KERNEL_ENTRIES
     benchmark_debug_syscall_start(cptr, msgInfo, syscall);
-    ksKernelEntry.is_fastpath = 0;
+    NODE_STATE(ksKernelEntry).is_fastpath = 0;
 #endif /* DEBUG */
 
     slowpath(syscall);
@@ -141,12 +142,12 @@ void VISIBLE c_handle_syscall(word_t cptr, word_t msgInfo, syscall_t syscall)
 ALIGN(L1_CACHE_LINE_SIZE)
 void VISIBLE c_handle_fastpath_call(word_t cptr, word_t msgInfo)
 {
-    NODE_LOCK_SYS;
+    NODE_LOCK_SYS_IF_NOT_CORE_LOCAL(isCoreLocalFastpathSyscall(SysCall));
 
     c_entry_hook();
 #ifdef TRACK_KERNEL_ENTRIES
     benchmark_debug_syscall_start(cptr, msgInfo, SysCall);
-    ksKernelEntry.is_fastpath = 1;
+    NODE_STATE(ksKernelEntry).is_fastpath = 1;
 #endif /* DEBUG */
 
     fastpath_call(cptr, msgInfo);
@@ -160,12 +161,12 @@ void VISIBLE c_handle_fastpath_reply_recv(word_t cptr, word_t msgInfo, word_t re
 void VISIBLE c_handle_fastpath_reply_recv(word_t cptr, word_t msgInfo)
 #endif
 {
-    NODE_LOCK_SYS;
+    NODE_LOCK_SYS_IF_NOT_CORE_LOCAL(isCoreLocalFastpathSyscall(SysReplyRecv));
 
     c_entry_hook();
 #ifdef TRACK_KERNEL_ENTRIES
     benchmark_debug_syscall_start(cptr, msgInfo, SysReplyRecv);
-    ksKernelEntry.is_fastpath = 1;
+    NODE_STATE(ksKernelEntry).is_fastpath = 1;
 #endif /* DEBUG */
 
 #ifdef CONFIG_KERNEL_MCS
@@ -176,6 +177,40 @@ void VISIBLE c_handle_fastpath_reply_recv(word_t cptr, word_t msgInfo)
     UNREACHABLE();
 }
 
+#ifdef CONFIG_FASTPATH_SEND
+ALIGN(L1_CACHE_LINE_SIZE)
+void VISIBLE c_handle_fastpath_send(word_t cptr, word_t msgInfo, syscall_t syscall)
+{
+    NODE_LOCK_SYS;
+
+    c_entry_hook();
+#ifdef TRACK_KERNEL_ENTRIES
+    benchmark_debug_syscall_start(cptr, msgInfo, syscall);
+    NODE_STATE(ksKernelEntry).is_fastpath = 1;
+#endif /* DEBUG */
+
+    fastpath_send(cptr, msgInfo, syscall);
+    UNREACHABLE();
+}
+#endif /* CONFIG_FASTPATH_SEND */
+
+#ifdef CONFIG_FASTPATH_WAIT
+ALIGN(L1_CACHE_LINE_SIZE)
+void VISIBLE c_handle_fastpath_wait(word_t cptr, word_t msgInfo, syscall_t syscall)
+{
+    NODE_LOCK_SYS;
+
+    c_entry_hook();
+#ifdef TRACK_KERNEL_ENTRIES
+    benchmark_debug_syscall_start(cptr, msgInfo, syscall);
+    NODE_STATE(ksKernelEntry).is_fastpath = 1;
+#endif /* DEBUG */
+
+    fastpath_wait(cptr, msgInfo, syscall);
+    UNREACHABLE();
+}
+#endif /* CONFIG_FASTPATH_WAIT */
+
 #endif
 
 #ifdef CONFIG_ARM_HYPERVISOR_SUPPORT
@@ -186,8 +221,8 @@ VISIBLE NORETURN void c_handle_vcpu_fault(word_t hsr)
     c_entry_hook();
 
 #ifdef TRACK_KERNEL_ENTRIES
-    ksKernelEntry.path = Entry_VCPUFault;
-    ksKernelEntry.word = hsr;
+    NODE_STATE(ksKernelEntry).path = Entry_VCPUFault;
+    NODE_STATE(ksKernelEntry).word = hsr;
 #endif
     handleVCPUFault(hsr);
     restore_user_context();
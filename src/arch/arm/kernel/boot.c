@@ -117,6 +117,9 @@ BOOT_CODE static void init_irqs(cap_t root_cnode_cap)
 #error "This platform doesn't support tracking CPU utilisation feature"
 #endif /* KERNEL_TIMER_IRQ */
 #endif /* CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT */
+#if defined(CONFIG_BENCHMARK_SAMPLING) && !defined(CONFIG_ARM_ENABLE_PMU_OVERFLOW_INTERRUPT)
+#error "This platform doesn't have the PMU interrupt needed for sampling"
+#endif
 
 #ifdef ENABLE_SMP_SUPPORT
     setIRQState(IRQIPI, CORE_IRQ_TO_IRQT(getCurrentCPUIndex(), irq_remote_call_ipi));
@@ -202,6 +205,10 @@ BOOT_CODE static bool_t init_cpu(void)
     setVtable((pptr_t)arm_vector_table);
 #endif /* CONFIG_ARCH_AARCH64 */
 
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+    arm_init_clear_memory();
+#endif
+
     haveHWFPU = fpsimd_HWCapTest();
 
     /* Disable FPU to avoid channels where a platform has an FPU but doesn't make use of it */
@@ -554,7 +561,7 @@ static BOOT_CODE bool_t try_init_kernel(
     ksNumCPUs = 1;
 
     /* initialize BKL before booting up other cores */
-    SMP_COND_STATEMENT(clh_lock_init());
+    SMP_COND_STATEMENT(kernel_lock_init());
     SMP_COND_STATEMENT(release_secondary_cpus());
 
     /* grab BKL before leaving the kernel */
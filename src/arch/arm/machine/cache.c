@@ -8,6 +8,7 @@
 #include <arch/machine.h>
 #include <arch/machine/hardware.h>
 #include <arch/machine/l2c_310.h>
+#include <model/statedata.h>
 
 #define LINE_START(a) ROUND_DOWN(a, L1_CACHE_LINE_SIZE_BITS)
 #define LINE_INDEX(a) (LINE_START(a)>>L1_CACHE_LINE_SIZE_BITS)
@@ -206,3 +207,37 @@ void arch_clean_invalidate_L1_caches(word_t type)
         isb();
     }
 }
+
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+BOOT_CODE void arm_init_clear_memory(void)
+{
+    word_t dczid;
+
+    /* All cores are assumed to report the same as the one that calls this
+     * last. */
+    MRS("dczid_el0", dczid);
+    if (dczid & BIT(4)) {
+        /* DZP: DC ZVA is prohibited */
+        armKSdczvaBlockBits = 0;
+    } else {
+        /* BS is log2 of the block size in words */
+        armKSdczvaBlockBits = (dczid & MASK(4)) + 2;
+    }
+}
+
+void clearMemoryStreaming(word_t *ptr, word_t bits)
+{
+    word_t p;
+
+    if (armKSdczvaBlockBits == 0 || bits < armKSdczvaBlockBits) {
+        memzero(ptr, BIT(bits));
+    } else {
+        for (p = (word_t)ptr; p < (word_t)ptr + BIT(bits); p += BIT(armKSdczvaBlockBits)) {
+            asm volatile("dc zva, %0" :: "r"(p) : "memory");
+        }
+        dsb();
+    }
+    cleanCacheRange_PoU((word_t)ptr, (word_t)ptr + BIT(bits) - 1,
+                        addrFromPPtr(ptr));
+}
+#endif /* CONFIG_CLEAR_MEMORY_STREAMING */
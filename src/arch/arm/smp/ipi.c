@@ -26,52 +26,64 @@ static inline void init_ipi_args(IpiRemoteCall_t func,
     totalCoreBarrier = popcountl(mask);
 }
 
-static void handleRemoteCall(IpiModeRemoteCall_t call, word_t arg0,
-                             word_t arg1, word_t arg2, bool_t irqPath)
+void handleRemoteCallOp(IpiRemoteCall_t call, word_t arg0,
+                        word_t arg1, word_t arg2, bool_t irqPath)
 {
-    /* we gets spurious irq_remote_call_ipi calls, e.g. when handling IPI
-     * in lock while hardware IPI is pending. Guard against spurious IPIs! */
-    if (clh_is_ipi_pending(getCurrentCPUIndex())) {
-        switch ((IpiRemoteCall_t)call) {
-        case IpiRemoteCall_Stall:
-            ipiStallCoreCallback(irqPath);
-            break;
+    switch (call) {
+    case IpiRemoteCall_Stall:
+        ipiStallCoreCallback(irqPath);
+        break;
 
 #ifdef CONFIG_HAVE_FPU
-        case IpiRemoteCall_switchFpuOwner:
-            switchLocalFpuOwner((user_fpu_state_t *)arg0);
-            break;
+    case IpiRemoteCall_switchFpuOwner:
+        switchLocalFpuOwner((user_fpu_state_t *)arg0);
+        break;
 #endif /* CONFIG_HAVE_FPU */
 
-        case IpiRemoteCall_InvalidateTranslationSingle:
-            invalidateTranslationSingleLocal(arg0);
-            break;
+    case IpiRemoteCall_InvalidateTranslationSingle:
+        invalidateTranslationSingleLocal(arg0);
+        break;
 
-        case IpiRemoteCall_InvalidateTranslationASID:
-            invalidateTranslationASIDLocal(arg0);
-            break;
+    case IpiRemoteCall_InvalidateTranslationASID:
+        invalidateTranslationASIDLocal(arg0);
+        break;
 
-        case IpiRemoteCall_InvalidateTranslationAll:
-            invalidateTranslationAllLocal();
-            break;
+    case IpiRemoteCall_InvalidateTranslationAll:
+        invalidateTranslationAllLocal();
+        break;
 
-        case IpiRemoteCall_MaskPrivateInterrupt:
-            maskInterrupt(arg0, IDX_TO_IRQT(arg1));
-            break;
+    case IpiRemoteCall_MaskPrivateInterrupt:
+        maskInterrupt(arg0, IDX_TO_IRQT(arg1));
+        break;
 
 #if defined CONFIG_ARM_HYPERVISOR_SUPPORT && defined ENABLE_SMP_SUPPORT
-        case IpiRemoteCall_VCPUInjectInterrupt: {
-            virq_t virq;
-            virq.words[0] = arg2;
-            handleVCPUInjectInterruptIPI((vcpu_t *) arg0, arg1, virq);
-            break;
-        }
+    case IpiRemoteCall_VCPUInjectInterrupt: {
+        virq_t virq;
+        virq.words[0] = arg2;
+        handleVCPUInjectInterruptIPI((vcpu_t *) arg0, arg1, virq);
+        break;
+    }
+#endif
+
+#ifdef CONFIG_SMP_BATCHED_REMOTE_CALLS
+    case IpiRemoteCall_Batch:
+        handleRemoteCallBatch(irqPath);
+        break;
 #endif
 
-        default:
-            fail("Invalid remote call");
-            break;
-        }
+    default:
+        fail("Invalid remote call");
+        break;
+    }
+}
+
+static void handleRemoteCall(IpiModeRemoteCall_t call, word_t arg0,
+                             word_t arg1, word_t arg2, bool_t irqPath)
+{
+    /* we gets spurious irq_remote_call_ipi calls, e.g. when handling IPI
+     * in lock while hardware IPI is pending. Guard against spurious IPIs! */
+    if (kernel_lock_is_ipi_pending(getCurrentCPUIndex())) {
+        handleRemoteCallOp((IpiRemoteCall_t)call, arg0, arg1, arg2, irqPath);
 
         big_kernel_lock.node_owners[getCurrentCPUIndex()].ipi = 0;
         ipi_wait(totalCoreBarrier);
@@ -101,7 +101,8 @@ void VISIBLE NORETURN restore_user_context(void)
 
 void VISIBLE NORETURN c_handle_interrupt(void)
 {
-    NODE_LOCK_IRQ_IF(getActiveIRQ() != irq_remote_call_ipi);
+    NODE_LOCK_IRQ_IF_NOT_CORE_LOCAL(getActiveIRQ() != irq_remote_call_ipi,
+                                    getActiveIRQ() == KERNEL_TIMER_IRQ);
 
     c_entry_hook();
 
@@ -148,12 +149,12 @@ void VISIBLE NORETURN slowpath(syscall_t syscall)
 {
     if (unlikely(syscall < SYSCALL_MIN || syscall > SYSCALL_MAX)) {
 #ifdef TRACK_KERNEL_ENTRIES
-        ksKernelEntry.path = Entry_UnknownSyscall;
+        NODE_STATE(ksKernelEntry).path = Entry_UnknownSyscall;
 #endif /* TRACK_KERNEL_ENTRIES */
         handleUnknownSyscall(syscall);
     } else {
 #ifdef TRACK_KERNEL_ENTRIES
-        ksKernelEntry.is_fastpath = 0;
+        NODE_STATE(ksKernelEntry).is_fastpath = 0;
 #endif /* TRACK KERNEL ENTRIES */
         handleSyscall(syscall);
     }
@@ -170,12 +171,12 @@ void VISIBLE c_handle_fastpath_reply_recv(word_t cptr, word_t msgInfo, word_t re
 void VISIBLE c_handle_fastpath_reply_recv(word_t cptr, word_t msgInfo)
 #endif
 {
-    NODE_LOCK_SYS;
+    NODE_LOCK_SYS_IF_NOT_CORE_LOCAL(isCoreLocalFastpathSyscall(SysReplyRecv));
 
     c_entry_hook();
 #ifdef TRACK_KERNEL_ENTRIES
     benchmark_debug_syscall_start(cptr, msgInfo, SysReplyRecv);
-    ksKernelEntry.is_fastpath = 1;
+    NODE_STATE(ksKernelEntry).is_fastpath = 1;
 #endif /* DEBUG */
 #ifdef CONFIG_KERNEL_MCS
     fastpath_reply_recv(cptr, msgInfo, reply);
@@ -188,28 +189,64 @@ void VISIBLE c_handle_fastpath_reply_recv(word_t cptr, word_t msgInfo)
 ALIGN(L1_CACHE_LINE_SIZE)
 void VISIBLE c_handle_fastpath_call(word_t cptr, word_t msgInfo)
 {
-    NODE_LOCK_SYS;
+    NODE_LOCK_SYS_IF_NOT_CORE_LOCAL(isCoreLocalFastpathSyscall(SysCall));
 
     c_entry_hook();
 #ifdef TRACK_KERNEL_ENTRIES
     benchmark_debug_syscall_start(cptr, msgInfo, SysCall);
-    ksKernelEntry.is_fastpath = 1;
+    NODE_STATE(ksKernelEntry).is_fastpath = 1;
 #endif /* DEBUG */
 
     fastpath_call(cptr, msgInfo);
 
     UNREACHABLE();
 }
+
+#ifdef CONFIG_FASTPATH_SEND
+ALIGN(L1_CACHE_LINE_SIZE)
+void VISIBLE c_handle_fastpath_send(word_t cptr, word_t msgInfo, syscall_t syscall)
+{
+    NODE_LOCK_SYS;
+
+    c_entry_hook();
+#ifdef TRACK_KERNEL_ENTRIES
+    benchmark_debug_syscall_start(cptr, msgInfo, syscall);
+    NODE_STATE(ksKernelEntry).is_fastpath = 1;
+#endif /* DEBUG */
+
+    fastpath_send(cptr, msgInfo, syscall);
+
+    UNREACHABLE();
+}
+#endif /* CONFIG_FASTPATH_SEND */
+
+#ifdef CONFIG_FASTPATH_WAIT
+ALIGN(L1_CACHE_LINE_SIZE)
+void VISIBLE c_handle_fastpath_wait(word_t cptr, word_t msgInfo, syscall_t syscall)
+{
+    NODE_LOCK_SYS;
+
+    c_entry_hook();
+#ifdef TRACK_KERNEL_ENTRIES
+    benchmark_debug_syscall_start(cptr, msgInfo, syscall);
+    NODE_STATE(ksKernelEntry).is_fastpath = 1;
+#endif /* DEBUG */
+
+    fastpath_wait(cptr, msgInfo, syscall);
+
+    UNREACHABLE();
+}
+#endif /* CONFIG_FASTPATH_WAIT */
 #endif
 
 void VISIBLE NORETURN c_handle_syscall(word_t cptr, word_t msgInfo, syscall_t syscall)
 {
-    NODE_LOCK_SYS;
+    NODE_LOCK_SYS_IF_NOT_CORE_LOCAL(isCoreLocalSyscall(syscall));
 
     c_entry_hook();
 #ifdef TRACK_KERNEL_ENTRIES
     benchmark_debug_syscall_start(cptr, msgInfo, syscall);
-    ksKernelEntry.is_fastpath = 0;
+    NODE_STATE(ksKernelEntry).is_fastpath = 0;
 #endif /* DEBUG */
     slowpath(syscall);
 
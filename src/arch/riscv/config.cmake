@@ -27,6 +27,22 @@ config_option(
     DEPENDS "KernelArchRiscV"
 )
 
+config_option(
+    KernelRiscvExtZicboz RISCV_EXT_ZICBOZ
+    "RISC-V extension for zeroing cache blocks (cbo.zero). The SBI implementation must\
+    enable cbo.zero for S-mode in menvcfg."
+    DEFAULT OFF
+    DEPENDS "KernelArchRiscV"
+)
+
+config_string(
+    KernelRiscvCbozBlockBits RISCV_CBOZ_BLOCK_BITS
+    "Size in bits of the cache block zeroed by cbo.zero on this platform."
+    DEFAULT 6
+    UNQUOTE
+    DEPENDS "KernelRiscvExtZicboz" UNDEF_DISABLED
+)
+
 # Until RISC-V has instructions to count leading/trailing zeros, we provide
 # library implementations. Platforms that implement the bit manipulation
 # extension can override these settings to remove the library functions from
@@ -399,7 +399,7 @@ static BOOT_CODE bool_t try_init_kernel(
 
     ksNumCPUs = 1;
 
-    SMP_COND_STATEMENT(clh_lock_init());
+    SMP_COND_STATEMENT(kernel_lock_init());
     SMP_COND_STATEMENT(release_secondary_cores());
 
     printf("Booting all finished, dropped to user space\n");
@@ -28,27 +28,33 @@ static inline void init_ipi_args(IpiRemoteCall_t func,
     totalCoreBarrier = popcountl(mask);
 }
 
-static void handleRemoteCall(IpiRemoteCall_t call, word_t arg0,
-                             word_t arg1, word_t arg2, bool_t irqPath)
+void handleRemoteCallOp(IpiRemoteCall_t call, word_t arg0,
+                        word_t arg1, word_t arg2, bool_t irqPath)
 {
-    /* we gets spurious irq_remote_call_ipi calls, e.g. when handling IPI
-     * in lock while hardware IPI is pending. Guard against spurious IPIs! */
-    if (clh_is_ipi_pending(getCurrentCPUIndex())) {
-        switch ((IpiRemoteCall_t)call) {
-        case IpiRemoteCall_Stall:
-            ipiStallCoreCallback(irqPath);
-            break;
+    switch (call) {
+    case IpiRemoteCall_Stall:
+        ipiStallCoreCallback(irqPath);
+        break;
 
 #ifdef CONFIG_HAVE_FPU
-        case IpiRemoteCall_switchFpuOwner:
-            switchLocalFpuOwner((user_fpu_state_t *)arg0);
-            break;
+    case IpiRemoteCall_switchFpuOwner:
+        switchLocalFpuOwner((user_fpu_state_t *)arg0);
+        break;
 #endif /* CONFIG_HAVE_FPU */
 
-        default:
-            fail("Invalid remote call");
-            break;
-        }
+    default:
+        fail("Invalid remote call");
+        break;
+    }
+}
+
+static void handleRemoteCall(IpiRemoteCall_t call, word_t arg0,
+                             word_t arg1, word_t arg2, bool_t irqPath)
+{
+    /* we gets spurious irq_remote_call_ipi calls, e.g. when handling IPI
+     * in lock while hardware IPI is pending. Guard against spurious IPIs! */
+    if (kernel_lock_is_ipi_pending(getCurrentCPUIndex())) {
+        handleRemoteCallOp(call, arg0, arg1, arg2, irqPath);
 
         big_kernel_lock.node_owners[getCurrentCPUIndex()].ipi = 0;
         ipiIrq[getCurrentCPUIndex()] = irqInvalid;
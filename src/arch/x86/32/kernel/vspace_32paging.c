@@ -15,6 +15,7 @@
 #include <arch/api/invocation.h>
 #include <arch/kernel/apic.h>
 #include <arch/kernel/vspace.h>
+#include <arch/kernel/tlb.h>
 #include <linker.h>
 #include <util.h>
 
@@ -197,6 +198,9 @@ void copyGlobalMappings(vspace_root_t *new_vspace)
 exception_t performASIDPoolInvocation(asid_t asid, asid_pool_t *poolPtr, cte_t *vspaceCapSlot)
 {
     asid_map_t asid_map;
+
+    /* the ASID may still be tagging translations of its previous vspace */
+    waitForLazyTLBShootdowns();
 #ifdef CONFIG_VTX
     if (cap_get_capType(vspaceCapSlot->cap) == cap_ept_pml4_cap) {
         cap_ept_pml4_cap_ptr_set_capPML4MappedASID(&vspaceCapSlot->cap, asid);
@@ -17,3 +17,64 @@ seL4_Word ksLogIndex = 0;
 seL4_Word ksLogIndexFinalized = 0;
 
 #endif /* CONFIG_MAX_NUM_TRACE_POINTS > 0 */
+
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+
+#include <arch/benchmark.h>
+#include <arch/machine.h>
+#include <linker.h>
+
+#define IA32_PERFEVTSEL0_MSR        0x186
+#define IA32_FIXED_CTR_CTRL_MSR     0x38D
+#define IA32_PERF_GLOBAL_CTRL_MSR   0x38F
+
+#define PERFEVTSEL_USR      BIT(16)
+#define PERFEVTSEL_OS       BIT(17)
+#define PERFEVTSEL_EN       BIT(22)
+/* count fixed counter 0 at user level and in the kernel */
+#define FIXED_CTR0_ENABLE   0x3
+#define RDPMC_FIXED         BIT(30)
+
+uint32_t benchmark_pmu_counter[BENCHMARK_PMU_NUM_EVENTS];
+
+/* Unit mask and event select of each event on a general purpose counter */
+static const uint16_t pmu_events[BENCHMARK_PMU_NUM_EVENTS] = {
+    [BENCHMARK_PMU_INSTRUCTIONS] = 0x00c0,  /* INST_RETIRED.ANY_P */
+    [BENCHMARK_PMU_L1D_MISSES] = 0x0151,    /* L1D.REPLACEMENT */
+    [BENCHMARK_PMU_L2_MISSES] = 0x412e,     /* LONGEST_LAT_CACHE.MISS */
+    [BENCHMARK_PMU_BRANCH_MISSES] = 0x00c5, /* BR_MISP_RETIRED.ALL_BRANCHES */
+    [BENCHMARK_PMU_TLB_MISSES] = 0x0108,    /* DTLB_LOAD_MISSES.MISS_CAUSES_A_WALK */
+};
+
+BOOT_CODE void benchmark_arch_pmu_init(void)
+{
+    /* CPUID leaf 0xA describes architectural performance monitoring; CPUs
+     * without it report version 0 and no counters */
+    uint32_t eax = x86_cpuid_eax(0xa, 0);
+    word_t version = eax & 0xff;
+    word_t num_counters = (eax >> 8) & 0xff;
+    word_t num_fixed = version > 1 ? x86_cpuid_edx(0xa, 0) & 0x1f : 0;
+    word_t counter = 0;
+    uint64_t enable = 0;
+
+    for (word_t i = 0; i < BENCHMARK_PMU_NUM_EVENTS; i++) {
+        if (i == BENCHMARK_PMU_INSTRUCTIONS && num_fixed > 0) {
+            x86_wrmsr(IA32_FIXED_CTR_CTRL_MSR, (x86_rdmsr(IA32_FIXED_CTR_CTRL_MSR) & ~0xfull) | FIXED_CTR0_ENABLE);
+            enable |= 1ull << 32;
+            benchmark_pmu_counter[i] = RDPMC_FIXED;
+        } else if (counter < num_counters) {
+            x86_wrmsr(IA32_PERFEVTSEL0_MSR + counter, pmu_events[i] | PERFEVTSEL_USR | PERFEVTSEL_OS | PERFEVTSEL_EN);
+            enable |= BIT(counter);
+            benchmark_pmu_counter[i] = counter;
+            counter++;
+        } else {
+            benchmark_pmu_counter[i] = BENCHMARK_PMU_NO_COUNTER;
+        }
+    }
+
+    /* from version 2 counters also have to be enabled globally */
+    if (version > 1) {
+        x86_wrmsr(IA32_PERF_GLOBAL_CTRL_MSR, x86_rdmsr(IA32_PERF_GLOBAL_CTRL_MSR) | enable);
+    }
+}
+#endif /* CONFIG_BENCHMARK_UTILISATION_PMU */
@@ -11,6 +11,7 @@
 #include <object/interrupt.h>
 #include <arch/object/interrupt.h>
 #include <arch/machine.h>
+#include <arch/benchmark.h>
 #include <arch/kernel/apic.h>
 #include <arch/kernel/boot.h>
 #include <arch/kernel/boot_sys.h>
@@ -404,6 +405,10 @@ BOOT_CODE bool_t init_cpu(
         return false;
     }
 
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+    x86_init_clear_memory();
+#endif
+
 #ifdef CONFIG_HARDWARE_DEBUG_API
     /* Initialize hardware breakpoints */
     Arch_initHardwareBreakpoints();
@@ -429,6 +434,10 @@ BOOT_CODE bool_t init_cpu(
         enablePMCUser();
     }
 
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+    benchmark_arch_pmu_init();
+#endif
+
 #ifdef CONFIG_VTX
     /* initialise Intel VT-x extensions */
     if (!vtx_init()) {
@@ -498,7 +498,7 @@ static BOOT_CODE bool_t try_boot_sys(void)
     }
 
     /* initialize BKL before booting up APs */
-    SMP_COND_STATEMENT(clh_lock_init());
+    SMP_COND_STATEMENT(kernel_lock_init());
     SMP_COND_STATEMENT(start_boot_aps());
 
     /* grab BKL before leaving the kernel */
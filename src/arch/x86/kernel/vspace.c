@@ -752,10 +752,56 @@ void unmapPage(vm_page_size_t page_size, asid_t asid, vptr_t vptr, void *pptr)
         break;
     }
 
+#ifdef CONFIG_REVOKE_BATCH
+    if (x86KSrevokeBatch.open) {
+        word_t remote = tlb_bitmap_get(find_ret.vspace_root) & ~BIT(getCurrentCPUIndex());
+
+        invalidateLocalTranslationSingleASID(vptr, asid);
+        if (remote != 0) {
+            if (x86KSrevokeBatch.pages == 0) {
+                x86KSrevokeBatch.sameASID = true;
+            } else if (x86KSrevokeBatch.asid != asid) {
+                x86KSrevokeBatch.sameASID = false;
+            }
+            x86KSrevokeBatch.mask |= remote;
+            x86KSrevokeBatch.vptr = vptr;
+            x86KSrevokeBatch.asid = asid;
+            x86KSrevokeBatch.pages++;
+        }
+        return;
+    }
+#endif
     invalidateTranslationSingleASID(vptr, asid,
                                     SMP_TERNARY(tlb_bitmap_get(find_ret.vspace_root), 0));
 }
 
+#ifdef CONFIG_REVOKE_BATCH
+void Arch_revokeBatchBegin(void)
+{
+    assert(!x86KSrevokeBatch.open);
+    x86KSrevokeBatch.open = true;
+    x86KSrevokeBatch.pages = 0;
+    x86KSrevokeBatch.mask = 0;
+}
+
+void Arch_revokeBatchEnd(void)
+{
+    x86KSrevokeBatch.open = false;
+    if (x86KSrevokeBatch.pages == 0) {
+        return;
+    }
+    if (x86KSrevokeBatch.pages == 1) {
+        doRemoteInvalidateTranslationSingleASID(x86KSrevokeBatch.vptr, x86KSrevokeBatch.asid,
+                                                x86KSrevokeBatch.mask);
+    } else if (x86KSrevokeBatch.sameASID) {
+        doRemoteInvalidateTranslationASID(x86KSrevokeBatch.asid, x86KSrevokeBatch.mask);
+    } else {
+        doRemoteInvalidateTranslationAll(x86KSrevokeBatch.mask);
+    }
+    x86KSrevokeBatch.mask = 0;
+}
+#endif
+
 void unmapPageTable(asid_t asid, vptr_t vaddr, pte_t *pt)
 {
     findVSpaceForASID_ret_t find_ret;
@@ -789,6 +835,7 @@ void unmapPageTable(asid_t asid, vptr_t vaddr, pte_t *pt)
 static exception_t performX86PageInvocationMapPTE(cap_t cap, cte_t *ctSlot, pte_t *ptSlot, pte_t pte,
                                                   vspace_root_t *vspace)
 {
+    waitForLazyTLBShootdowns();
     ctSlot->cap = cap;
     *ptSlot = pte;
     invalidatePageStructureCacheASID(pptr_to_paddr(vspace), cap_frame_cap_get_capFMappedASID(cap),
@@ -799,6 +846,7 @@ static exception_t performX86PageInvocationMapPTE(cap_t cap, cte_t *ctSlot, pte_
 static exception_t performX86PageInvocationMapPDE(cap_t cap, cte_t *ctSlot, pde_t *pdSlot, pde_t pde,
                                                   vspace_root_t *vspace)
 {
+    waitForLazyTLBShootdowns();
     ctSlot->cap = cap;
     *pdSlot = pde;
     invalidatePageStructureCacheASID(pptr_to_paddr(vspace), cap_frame_cap_get_capFMappedASID(cap),
@@ -920,6 +968,51 @@ static create_mapping_pde_return_t createSafeMappingEntries_PDE(paddr_t base, wo
     return ret;
 }
 
+#ifdef CONFIG_IPC_PAGE_GRANT
+/* Map the frame in frameSlot, which has just been transferred to receiver,
+ * at the receiver's receive window. This never fails the IPC: if the frame
+ * or the window is unsuitable, the frame is simply left unmapped. */
+bool_t Arch_mapReceiveWindow(tcb_t *receiver, cte_t *frameSlot, vptr_t window)
+{
+    cap_t cap = frameSlot->cap;
+    cap_t vspaceCap = TCB_PTR_CTE_PTR(receiver, tcbVTable)->cap;
+    vspace_root_t *vspace;
+    asid_t asid;
+    findVSpaceForASID_ret_t find_ret;
+    create_mapping_pte_return_t map_ret;
+
+    if (cap_get_capType(cap) != cap_frame_cap ||
+        cap_frame_cap_get_capFSize(cap) != X86_SmallPage ||
+        cap_frame_cap_get_capFMappedASID(cap) != asidInvalid) {
+        return false;
+    }
+
+    if (!isValidNativeRoot(vspaceCap) || window >= USER_TOP ||
+        !checkVPAlignment(X86_SmallPage, window)) {
+        return false;
+    }
+    vspace = (vspace_root_t *)pptr_of_cap(vspaceCap);
+    asid = cap_get_capMappedASID(vspaceCap);
+
+    find_ret = findVSpaceForASID(asid);
+    if (find_ret.status != EXCEPTION_NONE || find_ret.vspace_root != vspace) {
+        return false;
+    }
+
+    map_ret = createSafeMappingEntries_PTE(pptr_to_paddr((void *)cap_frame_cap_get_capFBasePtr(cap)), window,
+                                           cap_frame_cap_get_capFVMRights(cap), vmAttributesFromWord(0), vspace);
+    /* Never replace a mapping the receiver already has in the window. */
+    if (map_ret.status != EXCEPTION_NONE || pte_ptr_get_present(map_ret.ptSlot)) {
+        return false;
+    }
+
+    cap = cap_frame_cap_set_capFMappedASID(cap, asid);
+    cap = cap_frame_cap_set_capFMappedAddress(cap, window);
+    cap = cap_frame_cap_set_capFMapType(cap, X86_MappingVSpace);
+    performX86PageInvocationMapPTE(cap, frameSlot, map_ret.ptSlot, map_ret.pte, vspace);
+    return true;
+}
+#endif /* CONFIG_IPC_PAGE_GRANT */
 
 exception_t decodeX86FrameInvocation(
     word_t invLabel,
@@ -1121,6 +1214,7 @@ static exception_t performX86PageTableInvocationUnmap(cap_t cap, cte_t *ctSlot)
 static exception_t performX86PageTableInvocationMap(cap_t cap, cte_t *ctSlot, pde_t pde, pde_t *pdSlot,
                                                     vspace_root_t *root)
 {
+    waitForLazyTLBShootdowns();
     ctSlot->cap = cap;
     *pdSlot = pde;
     invalidatePageStructureCacheASID(pptr_to_paddr(root), cap_page_table_cap_get_capPTMappedASID(cap),
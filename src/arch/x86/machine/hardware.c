@@ -179,3 +179,45 @@ BOOT_CODE bool_t init_ibrs(void)
     }
     return true;
 }
+
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+BOOT_CODE void x86_init_clear_memory(void)
+{
+    cpuid_007h_ebx_t ebx_007;
+
+    /* All cores are assumed to report the same features as the one that
+     * calls this last. */
+    ebx_007.words[0] = x86_cpuid_ebx(0x7, 0);
+    if (x86_cpuid_edx(0x1, 0) & BIT(26)) {
+        /* SSE2, which provides movnti */
+        x86KSclearMemoryMethod = x86_clear_memory_movnti;
+    } else if (cpuid_007h_ebx_get_enhanced_rep_mov(ebx_007)) {
+        x86KSclearMemoryMethod = x86_clear_memory_rep_stosb;
+    } else {
+        x86KSclearMemoryMethod = x86_clear_memory_stores;
+    }
+}
+
+void clearMemoryStreaming(void *ptr, word_t bits)
+{
+    word_t *p = ptr;
+    word_t *end = p + (BIT(bits) / sizeof(word_t));
+    word_t n = BIT(bits);
+
+    switch (x86KSclearMemoryMethod) {
+    case x86_clear_memory_movnti:
+        for (; p < end; p++) {
+            asm volatile("movnti %1, %0" : "=m"(*p) : "r"((word_t)0));
+        }
+        break;
+
+    case x86_clear_memory_rep_stosb:
+        asm volatile("rep stosb" : "+D"(p), "+c"(n) : "a"(0) : "memory");
+        break;
+
+    default:
+        memzero(ptr, n);
+        break;
+    }
+}
+#endif /* CONFIG_CLEAR_MEMORY_STREAMING */
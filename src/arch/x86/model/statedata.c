@@ -39,6 +39,16 @@ SMP_STATE_DEFINE(cpu_id_mapping_t, cpu_mapping);
 /* CPU Cache Line Size */
 uint32_t x86KScacheLineSizeBits;
 
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+/* How clearMemoryStreaming zeroes memory, chosen at boot */
+uint32_t x86KSclearMemoryMethod;
+#endif
+
+#ifdef CONFIG_REVOKE_BATCH
+/* Remote TLB invalidations collected during the current revoke batch */
+x86_revoke_batch_t x86KSrevokeBatch;
+#endif
+
 /* A valid initial FPU state, copied to every new thread. */
 user_fpu_state_t x86KSnullFpuState ALIGN(MIN_FPU_ALIGNMENT);
 
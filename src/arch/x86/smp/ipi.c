@@ -26,49 +26,67 @@ static inline void init_ipi_args(IpiRemoteCall_t func,
     totalCoreBarrier = popcountl(mask);
 }
 
-static void handleRemoteCall(IpiModeRemoteCall_t call, word_t arg0,
-                             word_t arg1, word_t arg2, bool_t irqPath)
+void handleRemoteCallOp(IpiRemoteCall_t call, word_t arg0,
+                        word_t arg1, word_t arg2, bool_t irqPath)
 {
-    /* we gets spurious irq_remote_call_ipi calls, e.g. when handling IPI
-     * in lock while hardware IPI is pending. Guard against spurious IPIs! */
-    if (clh_is_ipi_pending(getCurrentCPUIndex())) {
-        switch ((IpiRemoteCall_t)call) {
-        case IpiRemoteCall_Stall:
-            ipiStallCoreCallback(irqPath);
-            break;
-
-        case IpiRemoteCall_InvalidatePageStructureCacheASID:
-            invalidateLocalPageStructureCacheASID(arg0, arg1);
-            break;
-
-        case IpiRemoteCall_InvalidateTranslationSingle:
-            invalidateLocalTranslationSingle(arg0);
-            break;
-
-        case IpiRemoteCall_InvalidateTranslationSingleASID:
-            invalidateLocalTranslationSingleASID(arg0, arg1);
-            break;
-
-        case IpiRemoteCall_InvalidateTranslationAll:
-            invalidateLocalTranslationAll();
-            break;
+    switch (call) {
+    case IpiRemoteCall_Stall:
+        ipiStallCoreCallback(irqPath);
+        break;
+
+    case IpiRemoteCall_InvalidatePageStructureCacheASID:
+        invalidateLocalPageStructureCacheASID(arg0, arg1);
+        break;
+
+    case IpiRemoteCall_InvalidateTranslationSingle:
+        invalidateLocalTranslationSingle(arg0);
+        break;
+
+    case IpiRemoteCall_InvalidateTranslationSingleASID:
+        invalidateLocalTranslationSingleASID(arg0, arg1);
+        break;
+
+    case IpiRemoteCall_InvalidateTranslationAll:
+        invalidateLocalTranslationAll();
+        break;
+
+#ifdef CONFIG_REVOKE_BATCH
+    case IpiRemoteCall_InvalidateTranslationASID:
+        invalidateLocalTranslationASID(arg0);
+        break;
+#endif
 
-        case IpiRemoteCall_switchFpuOwner:
-            switchLocalFpuOwner((user_fpu_state_t *)arg0);
-            break;
+    case IpiRemoteCall_switchFpuOwner:
+        switchLocalFpuOwner((user_fpu_state_t *)arg0);
+        break;
 
 #ifdef CONFIG_VTX
-        case IpiRemoteCall_ClearCurrentVCPU:
-            clearCurrentVCPU();
-            break;
-        case IpiRemoteCall_VMCheckBoundNotification:
-            VMCheckBoundNotification((tcb_t *)arg0);
-            break;
+    case IpiRemoteCall_ClearCurrentVCPU:
+        clearCurrentVCPU();
+        break;
+    case IpiRemoteCall_VMCheckBoundNotification:
+        VMCheckBoundNotification((tcb_t *)arg0);
+        break;
 #endif
-        default:
-            Mode_handleRemoteCall(call, arg0, arg1, arg2);
-            break;
-        }
+#ifdef CONFIG_SMP_BATCHED_REMOTE_CALLS
+    case IpiRemoteCall_Batch:
+        handleRemoteCallBatch(irqPath);
+        break;
+#endif
+
+    default:
+        Mode_handleRemoteCall((IpiModeRemoteCall_t)call, arg0, arg1, arg2);
+        break;
+    }
+}
+
+static void handleRemoteCall(IpiModeRemoteCall_t call, word_t arg0,
+                             word_t arg1, word_t arg2, bool_t irqPath)
+{
+    /* we gets spurious irq_remote_call_ipi calls, e.g. when handling IPI
+     * in lock while hardware IPI is pending. Guard against spurious IPIs! */
+    if (kernel_lock_is_ipi_pending(getCurrentCPUIndex())) {
+        handleRemoteCallOp((IpiRemoteCall_t)call, arg0, arg1, arg2, irqPath);
 
         big_kernel_lock.node_owners[getCurrentCPUIndex()].ipi = 0;
         ipi_wait(totalCoreBarrier);
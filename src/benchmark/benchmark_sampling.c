@@ -0,0 +1,59 @@
+/*
+ * Copyright 2020, Data61, CSIRO (ABN 41 687 119 230)
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include <config.h>
+#include <benchmark/benchmark_sampling.h>
+#include <arch/kernel/vspace.h>
+#include <arch/machine.h>
+#include <machine/registerset.h>
+#include <plat/machine/hardware.h>
+#include <model/statedata.h>
+
+#ifdef CONFIG_BENCHMARK_SAMPLING
+
+seL4_Word ksLogIndex;
+seL4_Word ksLogIndexFinalized;
+
+compile_assert(benchmark_sample_rings_fit_log_buffer,
+               sizeof(benchmark_sample_ring_t) * CONFIG_MAX_NUM_NODES <= seL4_LogBufferSize)
+
+void benchmark_sampling_reset(void)
+{
+    benchmark_sample_ring_t *rings = (benchmark_sample_ring_t *) KS_LOG_PPTR;
+
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        __atomic_store_n(&rings[i].head, 0, __ATOMIC_RELEASE);
+    }
+}
+
+void benchmark_sampling_record(void)
+{
+    benchmark_sample_ring_t *ring = &((benchmark_sample_ring_t *) KS_LOG_PPTR)[CURRENT_CPU_INDEX()];
+    tcb_t *tcb = NODE_STATE(ksCurThread);
+    benchmark_sample_t *sample;
+    word_t head;
+
+    if (unlikely(ksUserLogBuffer == 0 || !NODE_STATE(benchmark_log_utilisation_enabled))) {
+        return;
+    }
+
+    /* only this core writes to its ring, so head can be read plainly */
+    head = ring->head;
+    sample = &ring->samples[head % seL4_BenchmarkSampleRingEntries];
+    sample->tcb = (word_t) tcb;
+    sample->pc = getRegister(tcb, NextIP);
+    if (tcb == NODE_STATE(ksIdleThread)) {
+        /* the idle thread has no user-level stack to walk */
+        sample->depth = 0;
+    } else {
+        sample->depth = Arch_userCallStack(tcb, sample->callers, CONFIG_BENCHMARK_SAMPLING_STACK_DEPTH);
+    }
+    /* the sample has to be visible before the reader sees head move past it */
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    /* the total across all cores is reported by seL4_BenchmarkFinalizeLog */
+    ksLogIndex++;
+}
+#endif /* CONFIG_BENCHMARK_SAMPLING */
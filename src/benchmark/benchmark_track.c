@@ -10,10 +10,188 @@
 
 #ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
 
-timestamp_t ksEnter;
 seL4_Word ksLogIndex;
 seL4_Word ksLogIndexFinalized;
 
+#if CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0
+compile_assert(benchmark_track_histogram_fits_ipc_buffer,
+               sizeof(benchmark_track_histogram_t) <= seL4_MsgMaxLength * sizeof(seL4_Word))
+
+/* Each core counts its own kernel entries, as exits are recorded after the kernel
+ * lock is released. The tables are open addressed by kernel entry and merged by
+ * benchmark_track_histogram_get. A histogram with no entries counted is free. */
+typedef struct entry_histograms {
+    /* the tables are stale, and empty, when this is behind ksEntryHistogramsGeneration */
+    word_t generation;
+    word_t untracked;
+    word_t counts[CONFIG_BENCHMARK_TRACK_HISTOGRAMS];
+    benchmark_track_histogram_t histograms[CONFIG_BENCHMARK_TRACK_HISTOGRAMS];
+} entry_histograms_t;
+
+static entry_histograms_t ksEntryHistograms[CONFIG_MAX_NUM_NODES];
+/* Advanced on reset. Each core clears its own tables when it next counts an entry, so
+ * a reset never races with another core's update. */
+static word_t ksEntryHistogramsGeneration;
+
+/* Pack all the bits of a kernel entry; the syscall fields of the union cover
+ * the same bits as the others */
+static inline word_t histogram_key(kernel_entry_t entry)
+{
+    return entry.path | entry.syscall_no << 3 | entry.cap_type << 7 | entry.is_fastpath << 12 |
+           entry.invocation_tag << 13;
+}
+
+static inline bool_t histograms_live(entry_histograms_t *tables)
+{
+    return tables->generation == __atomic_load_n(&ksEntryHistogramsGeneration, __ATOMIC_RELAXED);
+}
+
+/* Slot holding key, or the free slot it would take. CONFIG_BENCHMARK_TRACK_HISTOGRAMS
+ * if neither exists. */
+static word_t histogram_slot(entry_histograms_t *tables, word_t key)
+{
+    word_t hash = (key * 2654435761u) % CONFIG_BENCHMARK_TRACK_HISTOGRAMS;
+
+    for (word_t i = 0; i < CONFIG_BENCHMARK_TRACK_HISTOGRAMS; i++) {
+        word_t slot = (hash + i) % CONFIG_BENCHMARK_TRACK_HISTOGRAMS;
+
+        if (tables->counts[slot] == 0 || histogram_key(tables->histograms[slot].entry) == key) {
+            return slot;
+        }
+    }
+    return CONFIG_BENCHMARK_TRACK_HISTOGRAMS;
+}
+
+static void benchmark_track_histogram_add(timestamp_t duration)
+{
+    entry_histograms_t *tables = &ksEntryHistograms[CURRENT_CPU_INDEX()];
+    kernel_entry_t entry = NODE_STATE(ksKernelEntry);
+    word_t bucket = 0;
+    word_t slot;
+
+    if (duration > 1) {
+        bucket = MIN(63 - clzll(duration), seL4_BenchmarkHistogramBuckets - 1);
+    }
+
+    /* entry paths only set the fields they use, so clear the others for the next key */
+    NODE_STATE(ksKernelEntry) = (kernel_entry_t) {
+        0
+    };
+
+    if (unlikely(!histograms_live(tables))) {
+        word_t generation = __atomic_load_n(&ksEntryHistogramsGeneration, __ATOMIC_RELAXED);
+        memzero(tables, sizeof(*tables));
+        __atomic_store_n(&tables->generation, generation, __ATOMIC_RELEASE);
+    }
+
+    slot = histogram_slot(tables, histogram_key(entry));
+    if (slot == CONFIG_BENCHMARK_TRACK_HISTOGRAMS) {
+        tables->untracked++;
+        return;
+    }
+    if (tables->counts[slot] == 0) {
+        tables->histograms[slot].entry = entry;
+    }
+    tables->histograms[slot].buckets[bucket]++;
+    /* publish the entry of a new histogram before other cores can see it in use */
+    __atomic_store_n(&tables->counts[slot], tables->counts[slot] + 1, __ATOMIC_RELEASE);
+}
+
+void benchmark_track_histograms_reset(void)
+{
+    __atomic_fetch_add(&ksEntryHistogramsGeneration, 1, __ATOMIC_RELAXED);
+}
+
+word_t benchmark_track_histogram_get(word_t index, benchmark_track_histogram_t *buffer)
+{
+    word_t node = index / CONFIG_BENCHMARK_TRACK_HISTOGRAMS;
+    word_t slot = index % CONFIG_BENCHMARK_TRACK_HISTOGRAMS;
+    entry_histograms_t *tables;
+    word_t count, key;
+
+    if (node >= CONFIG_MAX_NUM_NODES) {
+        return 0;
+    }
+    tables = &ksEntryHistograms[node];
+    if (!histograms_live(tables) || tables->counts[slot] == 0) {
+        return 0;
+    }
+
+    /* Other cores may still be counting, so the result can be a few entries behind.
+     * A kind of entry seen by several cores is returned merged at its lowest index. */
+    key = histogram_key(tables->histograms[slot].entry);
+    for (word_t i = 0; i < node; i++) {
+        if (histograms_live(&ksEntryHistograms[i])) {
+            word_t other = histogram_slot(&ksEntryHistograms[i], key);
+            if (other < CONFIG_BENCHMARK_TRACK_HISTOGRAMS && ksEntryHistograms[i].counts[other] != 0) {
+                return 0;
+            }
+        }
+    }
+
+    *buffer = tables->histograms[slot];
+    count = tables->counts[slot];
+    buffer->untracked = 0;
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        entry_histograms_t *other_tables = &ksEntryHistograms[i];
+        word_t other;
+
+        if (!histograms_live(other_tables)) {
+            continue;
+        }
+        buffer->untracked += other_tables->untracked;
+        if (i <= node) {
+            continue;
+        }
+        other = histogram_slot(other_tables, key);
+        if (other < CONFIG_BENCHMARK_TRACK_HISTOGRAMS && other_tables->counts[other] != 0) {
+            for (word_t b = 0; b < seL4_BenchmarkHistogramBuckets; b++) {
+                buffer->buckets[b] += other_tables->histograms[other].buckets[b];
+            }
+            count += other_tables->counts[other];
+        }
+    }
+    return count;
+}
+#endif /* CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0 */
+
+#ifdef CONFIG_BENCHMARK_TRACK_RING
+compile_assert(benchmark_track_rings_fit_log_buffer,
+               sizeof(benchmark_track_ring_t) * CONFIG_MAX_NUM_NODES <= seL4_LogBufferSize)
+
+void benchmark_track_ring_reset(void)
+{
+    benchmark_track_ring_t *rings = (benchmark_track_ring_t *) KS_LOG_PPTR;
+
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        __atomic_store_n(&rings[i].head, 0, __ATOMIC_RELEASE);
+    }
+}
+
+void benchmark_track_exit(void)
+{
+    timestamp_t ksExit = timestamp();
+    benchmark_track_ring_t *ring = &((benchmark_track_ring_t *) KS_LOG_PPTR)[CURRENT_CPU_INDEX()];
+
+    if (likely(ksUserLogBuffer != 0)) {
+        /* only this core writes to its ring, so head can be read plainly */
+        word_t head = ring->head;
+        benchmark_track_kernel_entry_t *log = &ring->entries[head % seL4_BenchmarkTrackRingEntries];
+
+        log->entry = NODE_STATE(ksKernelEntry);
+        log->start_time = NODE_STATE(ksEnter);
+        log->duration = ksExit - NODE_STATE(ksEnter);
+        /* the entry has to be visible before the reader sees head move past it */
+        __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+        /* the total across all cores is still reported by seL4_BenchmarkFinalizeLog,
+         * and cores exit the kernel concurrently */
+        __atomic_fetch_add(&ksLogIndex, 1, __ATOMIC_RELAXED);
+    }
+#if CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0
+    benchmark_track_histogram_add(ksExit - NODE_STATE(ksEnter));
+#endif
+}
+#else
 void benchmark_track_exit(void)
 {
     timestamp_t duration = 0;
@@ -23,12 +201,16 @@ void benchmark_track_exit(void)
     if (likely(ksUserLogBuffer != 0)) {
         /* If Log buffer is filled, do nothing */
         if (likely(ksLogIndex < MAX_LOG_SIZE)) {
-            duration = ksExit - ksEnter;
-            ksLog[ksLogIndex].entry = ksKernelEntry;
-            ksLog[ksLogIndex].start_time = ksEnter;
+            duration = ksExit - NODE_STATE(ksEnter);
+            ksLog[ksLogIndex].entry = NODE_STATE(ksKernelEntry);
+            ksLog[ksLogIndex].start_time = NODE_STATE(ksEnter);
             ksLog[ksLogIndex].duration = duration;
             ksLogIndex++;
         }
     }
+#if CONFIG_BENCHMARK_TRACK_HISTOGRAMS > 0
+    benchmark_track_histogram_add(ksExit - NODE_STATE(ksEnter));
+#endif
 }
+#endif /* CONFIG_BENCHMARK_TRACK_RING */
 #endif /* CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES */
@@ -9,8 +9,6 @@
 
 #ifdef CONFIG_BENCHMARK_TRACK_UTILISATION
 
-timestamp_t ksEnter;
-
 void benchmark_track_utilisation_dump(void)
 {
     uint64_t *buffer = ((uint64_t *) & (((seL4_IPCBuffer *)lookupIPCBuffer(true, NODE_STATE(ksCurThread)))->msg[0]));
@@ -64,6 +62,14 @@ void benchmark_track_utilisation_dump(void)
     buffer[BENCHMARK_TOTAL_NUMBER_SCHEDULES] = NODE_STATE(benchmark_kernel_number_schedules);
     buffer[BENCHMARK_TOTAL_KERNEL_UTILISATION] = NODE_STATE(benchmark_kernel_time);
     buffer[BENCHMARK_TOTAL_NUMBER_KERNEL_ENTRIES] = NODE_STATE(benchmark_kernel_number_entries);
+#ifdef CONFIG_SMP_BATCHED_REMOTE_CALLS
+    buffer[BENCHMARK_TOTAL_REMOTE_CALL_IPIS_SAVED] = remoteCallIPIsSaved;
+#endif
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+    for (word_t i = 0; i < BENCHMARK_PMU_NUM_EVENTS; i++) {
+        buffer[BENCHMARK_TCB_PMU_EVENTS + i] = tcb->benchmark.pmu_events[i];
+    }
+#endif
 
 }
 
@@ -74,5 +80,8 @@ void benchmark_track_reset_utilisation(tcb_t *tcb)
     tcb->benchmark.number_kernel_entries = 0;
     tcb->benchmark.kernel_utilisation = 0;
     tcb->benchmark.schedule_start_time = 0;
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+    memzero(tcb->benchmark.pmu_events, sizeof(tcb->benchmark.pmu_events));
+#endif
 }
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
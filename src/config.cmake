@@ -36,6 +36,7 @@ add_sources(
         src/machine/fpu.c
         src/benchmark/benchmark_track.c
         src/benchmark/benchmark_utilisation.c
+        src/benchmark/benchmark_sampling.c
         src/smp/lock.c
         src/smp/ipi.c
 )
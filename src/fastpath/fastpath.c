@@ -15,6 +15,38 @@
 #endif
 #include <benchmark/benchmark_utilisation.h>
 
+#ifdef CONFIG_FASTPATH_CROSS_CORE
+/* Wake a receiver that has affinity to another core. It cannot be switched
+ * to here, so its reply registers are written directly and it is queued on
+ * its own core. Queueing records any reschedule IPI that core needs, and the
+ * IPIs are sent together, once, on the way out of the kernel. */
+static inline void NORETURN FORCE_INLINE fastpath_wake_remote(tcb_t *dest, word_t badge, word_t msgInfo)
+{
+    setRegister(dest, msgInfoRegister, msgInfo);
+    setRegister(dest, badgeRegister, badge);
+    SCHED_ENQUEUE(dest);
+
+    if (likely(isRunnable(NODE_STATE(ksCurThread)))) {
+        /* The sender keeps running, so only the IPI is left to do. */
+        doMaskReschedule(ARCH_NODE_STATE(ipiReschedulePending));
+        ARCH_NODE_STATE(ipiReschedulePending) = 0;
+    } else {
+        /* The sender has blocked, and schedule() sends the IPI. */
+        rescheduleRequired();
+        schedule();
+        activateThread();
+    }
+
+    restore_user_context();
+    UNREACHABLE();
+}
+#endif /* CONFIG_FASTPATH_CROSS_CORE */
+
+#if defined(CONFIG_FASTPATH_CROSS_CORE) && defined(CONFIG_SMP_CORE_LOCAL_ENTRIES)
+static void NORETURN NO_INLINE fastpath_call_locked(word_t cptr, word_t msgInfo);
+static void NORETURN NO_INLINE fastpath_reply_recv_locked(word_t cptr, word_t msgInfo);
+#endif
+
 #ifdef CONFIG_ARCH_ARM
 static inline
 #ifndef CONFIG_ARCH_ARM_V6
@@ -42,7 +74,11 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
 
     /* Check there's no extra caps, the length is ok and there's no
      * saved fault. */
+#ifdef CONFIG_FASTPATH_LONG_MESSAGES
+    if (unlikely(fastpath_long_mi_check(msgInfo) ||
+#else
     if (unlikely(fastpath_mi_check(msgInfo) ||
+#endif
                  fault_type != seL4_Fault_NullFault)) {
         slowpath(SysCall);
     }
@@ -59,6 +95,14 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
     /* Get the endpoint address */
     ep_ptr = EP_PTR(cap_endpoint_cap_get_capEPPtr(ep_cap));
 
+#ifdef CONFIG_SMP_CORE_LOCAL_ENTRIES
+    /* Without the big kernel lock, lock the endpoint against fastpaths on other cores */
+    if (!kernel_lock_is_self_in_queue() &&
+        unlikely(!core_local_try_lock_ep(getCurrentCPUIndex(), ep_ptr))) {
+        slowpath(SysCall);
+    }
+#endif
+
     /* Get the destination thread, which is only going to be valid
      * if the endpoint is valid. */
     dest = TCB_PTR(endpoint_ptr_get_epQueue_head(ep_ptr));
@@ -113,6 +157,10 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
     dom = maxDom ? ksCurDomain : 0;
     /* ensure only the idle thread or lower prio threads are present in the scheduler */
     if (unlikely(dest->tcbPriority < NODE_STATE(ksCurThread->tcbPriority) &&
+#ifdef CONFIG_FASTPATH_CROSS_CORE
+                 /* a remote receiver is scheduled by its own core */
+                 dest->tcbAffinity == getCurrentCPUIndex() &&
+#endif
                  !isHighestPrio(dom, dest->tcbPriority))) {
         slowpath(SysCall);
     }
@@ -146,12 +194,26 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
     }
 #endif
 
-#ifdef ENABLE_SMP_SUPPORT
+#if defined(ENABLE_SMP_SUPPORT) && !defined(CONFIG_FASTPATH_CROSS_CORE)
     /* Ensure both threads have the same affinity */
     if (unlikely(NODE_STATE(ksCurThread)->tcbAffinity != dest->tcbAffinity)) {
         slowpath(SysCall);
     }
-#endif /* ENABLE_SMP_SUPPORT */
+#endif /* ENABLE_SMP_SUPPORT && !CONFIG_FASTPATH_CROSS_CORE */
+
+#if defined(CONFIG_FASTPATH_CROSS_CORE) && defined(CONFIG_SMP_CORE_LOCAL_ENTRIES)
+    /* Waking a receiver on another core needs the big kernel lock */
+    if (unlikely(dest->tcbAffinity != getCurrentCPUIndex() && !kernel_lock_is_self_in_queue())) {
+        fastpath_call_locked(cptr, msgInfo);
+    }
+#endif
+
+#ifdef CONFIG_FASTPATH_LONG_MESSAGES
+    word_t *sendBuf, *recvBuf;
+    if (unlikely(!fastpath_lookup_ipc_buffers(length, NODE_STATE(ksCurThread), dest, &sendBuf, &recvBuf))) {
+        slowpath(SysCall);
+    }
+#endif
 
     /*
      * --- POINT OF NO RETURN ---
@@ -160,7 +222,7 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
      */
 
 #ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
-    ksKernelEntry.is_fastpath = true;
+    NODE_STATE(ksKernelEntry).is_fastpath = true;
 #endif
 
     /* Dequeue the destination. */
@@ -209,11 +271,21 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
         &replySlot->cteMDBNode, CTE_REF(callerSlot), 1, 1);
 #endif
 
+#ifdef CONFIG_FASTPATH_LONG_MESSAGES
+    fastpath_copy_long_mrs(length, NODE_STATE(ksCurThread), dest, sendBuf, recvBuf);
+#else
     fastpath_copy_mrs(length, NODE_STATE(ksCurThread), dest);
+#endif
 
     /* Dest thread is set Running, but not queued. */
     thread_state_ptr_set_tsType_np(&dest->tcbState,
                                    ThreadState_Running);
+#ifdef CONFIG_FASTPATH_CROSS_CORE
+    if (unlikely(dest->tcbAffinity != getCurrentCPUIndex())) {
+        fastpath_wake_remote(dest, badge,
+                             wordFromMessageInfo(seL4_MessageInfo_set_capsUnwrapped(info, 0)));
+    }
+#endif
     switchToThread_fp(dest, cap_pd, stored_hw_asid);
 
     msgInfo = wordFromMessageInfo(seL4_MessageInfo_set_capsUnwrapped(info, 0));
@@ -221,6 +293,18 @@ void NORETURN fastpath_call(word_t cptr, word_t msgInfo)
     fastpath_restore(badge, msgInfo, NODE_STATE(ksCurThread));
 }
 
+#if defined(CONFIG_FASTPATH_CROSS_CORE) && defined(CONFIG_SMP_CORE_LOCAL_ENTRIES)
+/* A Call started as a core-local entry found its receiver on another core.
+ * Nothing has been changed yet, so it is started again under the big kernel
+ * lock, which lets it wake the receiver there. */
+static void NORETURN NO_INLINE fastpath_call_locked(word_t cptr, word_t msgInfo)
+{
+    core_local_exit(getCurrentCPUIndex());
+    NODE_LOCK_SYS;
+    fastpath_call(cptr, msgInfo);
+}
+#endif
+
 #ifdef CONFIG_ARCH_ARM
 static inline
 #ifndef CONFIG_ARCH_ARM_V6
@@ -254,7 +338,11 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
 
     /* Check there's no extra caps, the length is ok and there's no
      * saved fault. */
+#ifdef CONFIG_FASTPATH_LONG_MESSAGES
+    if (unlikely(fastpath_long_mi_check(msgInfo) ||
+#else
     if (unlikely(fastpath_mi_check(msgInfo) ||
+#endif
                  fault_type != seL4_Fault_NullFault)) {
         slowpath(SysReplyRecv);
     }
@@ -288,6 +376,14 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
     /* Get the endpoint address */
     ep_ptr = EP_PTR(cap_endpoint_cap_get_capEPPtr(ep_cap));
 
+#ifdef CONFIG_SMP_CORE_LOCAL_ENTRIES
+    /* Without the big kernel lock, lock the endpoint against fastpaths on other cores */
+    if (!kernel_lock_is_self_in_queue() &&
+        unlikely(!core_local_try_lock_ep(getCurrentCPUIndex(), ep_ptr))) {
+        slowpath(SysReplyRecv);
+    }
+#endif
+
     /* Check that there's not a thread waiting to send */
     if (unlikely(endpoint_ptr_get_state(ep_ptr) == EPState_Send)) {
         slowpath(SysReplyRecv);
@@ -365,7 +461,12 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
 
     /* Ensure the original caller can be scheduled directly. */
     dom = maxDom ? ksCurDomain : 0;
-    if (unlikely(!isHighestPrio(dom, caller->tcbPriority))) {
+    if (unlikely(
+#ifdef CONFIG_FASTPATH_CROSS_CORE
+            /* a remote caller is scheduled by its own core */
+            caller->tcbAffinity == getCurrentCPUIndex() &&
+#endif
+            !isHighestPrio(dom, caller->tcbPriority))) {
         slowpath(SysReplyRecv);
     }
 
@@ -387,18 +488,32 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
     }
 #endif
 
-#ifdef ENABLE_SMP_SUPPORT
+#if defined(ENABLE_SMP_SUPPORT) && !defined(CONFIG_FASTPATH_CROSS_CORE)
     /* Ensure both threads have the same affinity */
     if (unlikely(NODE_STATE(ksCurThread)->tcbAffinity != caller->tcbAffinity)) {
         slowpath(SysReplyRecv);
     }
-#endif /* ENABLE_SMP_SUPPORT */
+#endif /* ENABLE_SMP_SUPPORT && !CONFIG_FASTPATH_CROSS_CORE */
+
+#if defined(CONFIG_FASTPATH_CROSS_CORE) && defined(CONFIG_SMP_CORE_LOCAL_ENTRIES)
+    /* Waking a caller on another core needs the big kernel lock */
+    if (unlikely(caller->tcbAffinity != getCurrentCPUIndex() && !kernel_lock_is_self_in_queue())) {
+        fastpath_reply_recv_locked(cptr, msgInfo);
+    }
+#endif
 
 #ifdef CONFIG_KERNEL_MCS
     /* not possible to set reply object and not be blocked */
     assert(thread_state_get_replyObject(NODE_STATE(ksCurThread)->tcbState) == 0);
 #endif
 
+#ifdef CONFIG_FASTPATH_LONG_MESSAGES
+    word_t *sendBuf, *recvBuf;
+    if (unlikely(!fastpath_lookup_ipc_buffers(length, NODE_STATE(ksCurThread), caller, &sendBuf, &recvBuf))) {
+        slowpath(SysReplyRecv);
+    }
+#endif
+
     /*
      * --- POINT OF NO RETURN ---
      *
@@ -406,7 +521,7 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
      */
 
 #ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
-    ksKernelEntry.is_fastpath = true;
+    NODE_STATE(ksKernelEntry).is_fastpath = true;
 #endif
 
     /* Set thread state to BlockedOnReceive */
@@ -481,14 +596,469 @@ void NORETURN fastpath_reply_recv(word_t cptr, word_t msgInfo)
     /* Replies don't have a badge. */
     badge = 0;
 
+#ifdef CONFIG_FASTPATH_LONG_MESSAGES
+    fastpath_copy_long_mrs(length, NODE_STATE(ksCurThread), caller, sendBuf, recvBuf);
+#else
     fastpath_copy_mrs(length, NODE_STATE(ksCurThread), caller);
+#endif
 
     /* Dest thread is set Running, but not queued. */
     thread_state_ptr_set_tsType_np(&caller->tcbState,
                                    ThreadState_Running);
+#ifdef CONFIG_FASTPATH_CROSS_CORE
+    if (unlikely(caller->tcbAffinity != getCurrentCPUIndex())) {
+        fastpath_wake_remote(caller, badge,
+                             wordFromMessageInfo(seL4_MessageInfo_set_capsUnwrapped(info, 0)));
+    }
+#endif
     switchToThread_fp(caller, cap_pd, stored_hw_asid);
 
     msgInfo = wordFromMessageInfo(seL4_MessageInfo_set_capsUnwrapped(info, 0));
 
     fastpath_restore(badge, msgInfo, NODE_STATE(ksCurThread));
 }
+
+#if defined(CONFIG_FASTPATH_CROSS_CORE) && defined(CONFIG_SMP_CORE_LOCAL_ENTRIES)
+/* As fastpath_call_locked, for a ReplyRecv whose caller is on another core. */
+static void NORETURN NO_INLINE fastpath_reply_recv_locked(word_t cptr, word_t msgInfo)
+{
+    core_local_exit(getCurrentCPUIndex());
+    NODE_LOCK_SYS;
+    fastpath_reply_recv(cptr, msgInfo);
+}
+#endif
+
+#ifdef CONFIG_FASTPATH_SEND
+/* Check that a thread made runnable by a one-way send can be woken without
+ * going through schedule(). If it outranks the sender it will be switched
+ * to directly, in which case its vspace root and ASID are returned, and
+ * otherwise it is queued while the sender keeps running. */
+static inline bool_t FORCE_INLINE fastpath_wake_check(tcb_t *dest, bool_t *switch_to_dest,
+                                                      vspace_root_t **cap_pd, pde_t *stored_hw_asid)
+{
+    /* The sender may keep running, so the scheduler must not have any
+     * pending decision that the slowpath would act on at exit. */
+    if (unlikely(NODE_STATE(ksSchedulerAction) != SchedulerAction_ResumeCurrentThread)) {
+        return false;
+    }
+
+    /* Ensure the receiver is in the current domain. */
+    if (unlikely(dest->tcbDomain != ksCurDomain && maxDom)) {
+        return false;
+    }
+
+#ifdef ENABLE_SMP_SUPPORT
+    /* Ensure both threads have the same affinity */
+    if (unlikely(NODE_STATE(ksCurThread)->tcbAffinity != dest->tcbAffinity)) {
+#ifdef CONFIG_FASTPATH_CROSS_CORE
+        /* or wake the receiver on its own core */
+        *switch_to_dest = false;
+        return true;
+#else
+        return false;
+#endif
+    }
+#endif /* ENABLE_SMP_SUPPORT */
+
+    *switch_to_dest = dest->tcbPriority > NODE_STATE(ksCurThread)->tcbPriority;
+
+#ifdef CONFIG_KERNEL_MCS
+    /* A passive receiver is simply made runnable. An active receiver
+     * must be queueable without refill maintenance, and switching to it
+     * requires a scheduling context switch which is left to the slowpath. */
+    sched_context_t *sc = dest->tcbSchedContext;
+    if (unlikely(sc != NULL &&
+                 (*switch_to_dest || sc_sporadic(sc) || !sc_active(sc) ||
+                  thread_state_get_tcbInReleaseQueue(dest->tcbState)))) {
+        return false;
+    }
+#else
+    if (*switch_to_dest) {
+        cap_t newVTable;
+        dom_t dom;
+
+        /* ensure we are not single stepping the destination in ia32 */
+#if defined(CONFIG_HARDWARE_DEBUG_API) && defined(CONFIG_ARCH_IA32)
+        if (unlikely(dest->tcbArch.tcbContext.breakpointState.single_step_enabled)) {
+            return false;
+        }
+#endif
+
+        /* Get destination thread.*/
+        newVTable = TCB_PTR_CTE_PTR(dest, tcbVTable)->cap;
+
+        /* Get vspace root. */
+        *cap_pd = cap_vtable_cap_get_vspace_root_fp(newVTable);
+
+        /* Ensure that the destination has a valid VTable. */
+        if (unlikely(! isValidVTableRoot_fp(newVTable))) {
+            return false;
+        }
+
+#ifdef CONFIG_ARCH_AARCH32
+        /* Get HW ASID */
+        *stored_hw_asid = (*cap_pd)[PD_ASID_SLOT];
+#endif
+
+#ifdef CONFIG_ARCH_X86_64
+        /* borrow the stored_hw_asid for PCID */
+        stored_hw_asid->words[0] = cap_pml4_cap_get_capPML4MappedASID_fp(newVTable);
+#endif
+
+#ifdef CONFIG_ARCH_IA32
+        /* stored_hw_asid is unused on ia32 fastpath, but gets passed into a function below. */
+        stored_hw_asid->words[0] = 0;
+#endif
+#ifdef CONFIG_ARCH_AARCH64
+        stored_hw_asid->words[0] = cap_vtable_root_get_mappedASID(newVTable);
+#endif
+
+#ifdef CONFIG_ARCH_RISCV
+        /* Get HW ASID */
+        stored_hw_asid->words[0] = cap_page_table_cap_get_capPTMappedASID(newVTable);
+#endif
+
+        /* let gcc optimise this out for 1 domain */
+        dom = maxDom ? ksCurDomain : 0;
+        /* ensure no thread queued in the scheduler outranks the receiver */
+        if (unlikely(!isHighestPrio(dom, dest->tcbPriority))) {
+            return false;
+        }
+
+#ifdef CONFIG_ARCH_AARCH32
+        if (unlikely(!pde_pde_invalid_get_stored_asid_valid(*stored_hw_asid))) {
+            return false;
+        }
+#endif
+    }
+#endif /* CONFIG_KERNEL_MCS */
+
+    return true;
+}
+
+/* Make a thread that passed fastpath_wake_check runnable, delivering the
+ * badge and message info registers, and return to whichever of it and the
+ * sender runs next. */
+static inline void NORETURN FORCE_INLINE fastpath_wake(tcb_t *dest, bool_t switch_to_dest,
+                                                       vspace_root_t *cap_pd, pde_t stored_hw_asid,
+                                                       word_t badge, word_t msgInfo)
+{
+    /* Dest thread is set Running, queued below if it does not run next. */
+    thread_state_ptr_set_tsType_np(&dest->tcbState,
+                                   ThreadState_Running);
+
+#ifdef CONFIG_FASTPATH_CROSS_CORE
+    if (unlikely(dest->tcbAffinity != getCurrentCPUIndex())) {
+        fastpath_wake_remote(dest, badge, msgInfo);
+    }
+#endif
+
+#ifndef CONFIG_KERNEL_MCS
+    if (switch_to_dest) {
+        /* The sender stays runnable at the head of its queue, as it would
+         * after schedule() on the slowpath. */
+        SCHED_ENQUEUE_CURRENT_TCB;
+        switchToThread_fp(dest, cap_pd, stored_hw_asid);
+
+        fastpath_restore(badge, msgInfo, NODE_STATE(ksCurThread));
+    }
+#endif
+
+    setRegister(dest, msgInfoRegister, msgInfo);
+    setRegister(dest, badgeRegister, badge);
+
+#ifdef CONFIG_KERNEL_MCS
+    if (dest->tcbSchedContext != NULL)
+#endif
+    {
+        /* Mirror schedule(): equal priority receivers go behind the sender. */
+        if (dest->tcbPriority == NODE_STATE(ksCurThread)->tcbPriority) {
+            SCHED_APPEND(dest);
+        } else {
+            SCHED_ENQUEUE(dest);
+        }
+    }
+
+    restore_user_context();
+    UNREACHABLE();
+}
+
+#ifdef CONFIG_FASTPATH_SIGNAL
+/* Signal a notification from the Send fastpath. Updating an idle or active
+ * notification and waking a single waiter, or a bound thread blocked on an
+ * endpoint, are handled here; everything else goes to the slowpath. */
+static inline void NORETURN FORCE_INLINE fastpath_signal(cap_t ntfn_cap, syscall_t syscall)
+{
+    notification_t *ntfn_ptr;
+    tcb_t *dest;
+    word_t badge;
+    bool_t switch_to_dest;
+    /* only looked up, and used, when switching to the woken thread */
+    vspace_root_t *cap_pd = NULL;
+    pde_t stored_hw_asid = { { 0 } };
+
+    if (unlikely(!cap_notification_cap_get_capNtfnCanSend(ntfn_cap))) {
+        slowpath(syscall);
+    }
+
+    ntfn_ptr = NTFN_PTR(cap_notification_cap_get_capNtfnPtr(ntfn_cap));
+    badge = cap_notification_cap_get_capNtfnBadge(ntfn_cap);
+
+    switch (notification_ptr_get_state(ntfn_ptr)) {
+    case NtfnState_Active:
+        /* Nobody to wake, just accumulate the badge. */
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
+        NODE_STATE(ksKernelEntry).is_fastpath = true;
+#endif
+        notification_ptr_set_ntfnMsgIdentifier(ntfn_ptr,
+                                               notification_ptr_get_ntfnMsgIdentifier(ntfn_ptr) | badge);
+        restore_user_context();
+
+    case NtfnState_Waiting:
+        dest = TCB_PTR(notification_ptr_get_ntfnQueue_head(ntfn_ptr));
+        break;
+
+    default:
+        dest = TCB_PTR(notification_ptr_get_ntfnBoundTCB(ntfn_ptr));
+        if (dest == NULL ||
+            thread_state_ptr_get_tsType(&dest->tcbState) != ThreadState_BlockedOnReceive) {
+#ifdef CONFIG_VTX
+            /* waking a thread running a VM needs the slowpath */
+            if (unlikely(dest != NULL &&
+                         thread_state_ptr_get_tsType(&dest->tcbState) == ThreadState_RunningVM)) {
+                slowpath(syscall);
+            }
+#endif
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
+            NODE_STATE(ksKernelEntry).is_fastpath = true;
+#endif
+            notification_ptr_set_state(ntfn_ptr, NtfnState_Active);
+            notification_ptr_set_ntfnMsgIdentifier(ntfn_ptr, badge);
+            restore_user_context();
+        }
+        break;
+    }
+
+#ifdef CONFIG_KERNEL_MCS
+    /* A thread without a scheduling context may need one donated from the
+     * notification, which is left to the slowpath. */
+    if (unlikely(dest->tcbSchedContext == NULL)) {
+        slowpath(syscall);
+    }
+#endif
+
+    if (unlikely(!fastpath_wake_check(dest, &switch_to_dest, &cap_pd, &stored_hw_asid))) {
+        slowpath(syscall);
+    }
+
+    /*
+     * --- POINT OF NO RETURN ---
+     *
+     * At this stage, we have committed to waking the thread.
+     */
+
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
+    NODE_STATE(ksKernelEntry).is_fastpath = true;
+#endif
+
+    if (notification_ptr_get_state(ntfn_ptr) == NtfnState_Waiting) {
+        /* Dequeue the waiter, the notification is idle once nobody waits. */
+        notification_ptr_set_ntfnQueue_head(ntfn_ptr, TCB_REF(dest->tcbEPNext));
+        if (unlikely(dest->tcbEPNext)) {
+            dest->tcbEPNext->tcbEPPrev = NULL;
+        } else {
+            notification_ptr_set_ntfnQueue_tail(ntfn_ptr, 0);
+            notification_ptr_set_state(ntfn_ptr, NtfnState_Idle);
+        }
+    } else {
+        /* Take the bound thread off the endpoint it is waiting on. */
+        cancelIPC(dest);
+    }
+
+    /* A signal only delivers the badge. */
+    fastpath_wake(dest, switch_to_dest, cap_pd, stored_hw_asid,
+                  badge, getRegister(dest, msgInfoRegister));
+}
+#endif /* CONFIG_FASTPATH_SIGNAL */
+
+#ifdef CONFIG_ARCH_ARM
+static inline
+#ifndef CONFIG_ARCH_ARM_V6
+FORCE_INLINE
+#endif
+#endif
+void NORETURN fastpath_send(word_t cptr, word_t msgInfo, syscall_t syscall)
+{
+    seL4_MessageInfo_t info;
+    cap_t ep_cap;
+    endpoint_t *ep_ptr;
+    word_t length;
+    tcb_t *dest;
+    word_t badge;
+    word_t fault_type;
+    bool_t switch_to_dest;
+    /* only looked up, and used, when switching to the receiver */
+    vspace_root_t *cap_pd = NULL;
+    pde_t stored_hw_asid = { { 0 } };
+
+    /* Get message info, length, and fault type. */
+    info = messageInfoFromWord_raw(msgInfo);
+    length = seL4_MessageInfo_get_length(info);
+    fault_type = seL4_Fault_get_seL4_FaultType(NODE_STATE(ksCurThread)->tcbFault);
+
+    /* Check there's no extra caps, the length is ok and there's no
+     * saved fault. */
+#ifdef CONFIG_FASTPATH_LONG_MESSAGES
+    if (unlikely(fastpath_long_mi_check(msgInfo) ||
+#else
+    if (unlikely(fastpath_mi_check(msgInfo) ||
+#endif
+                 fault_type != seL4_Fault_NullFault)) {
+        slowpath(syscall);
+    }
+
+    /* Lookup the cap */
+    ep_cap = lookup_fp(TCB_PTR_CTE_PTR(NODE_STATE(ksCurThread), tcbCTable)->cap, cptr);
+
+#ifdef CONFIG_FASTPATH_SIGNAL
+    /* seL4_Signal is a Send on a notification cap */
+    if (cap_capType_equals(ep_cap, cap_notification_cap)) {
+        fastpath_signal(ep_cap, syscall);
+    }
+#endif
+
+    /* Check it's an endpoint */
+    if (unlikely(!cap_capType_equals(ep_cap, cap_endpoint_cap) ||
+                 !cap_endpoint_cap_get_capCanSend(ep_cap))) {
+        slowpath(syscall);
+    }
+
+    /* Get the endpoint address */
+    ep_ptr = EP_PTR(cap_endpoint_cap_get_capEPPtr(ep_cap));
+
+    /* Get the destination thread, which is only going to be valid
+     * if the endpoint is valid. */
+    dest = TCB_PTR(endpoint_ptr_get_epQueue_head(ep_ptr));
+
+    /* Check that there's a thread waiting to receive. With a receiver
+     * present Send and NBSend behave identically. */
+    if (unlikely(endpoint_ptr_get_state(ep_ptr) != EPState_Recv)) {
+        slowpath(syscall);
+    }
+
+    if (unlikely(!fastpath_wake_check(dest, &switch_to_dest, &cap_pd, &stored_hw_asid))) {
+        slowpath(syscall);
+    }
+
+#ifdef CONFIG_FASTPATH_LONG_MESSAGES
+    word_t *sendBuf, *recvBuf;
+    if (unlikely(!fastpath_lookup_ipc_buffers(length, NODE_STATE(ksCurThread), dest, &sendBuf, &recvBuf))) {
+        slowpath(syscall);
+    }
+#endif
+
+    /*
+     * --- POINT OF NO RETURN ---
+     *
+     * At this stage, we have committed to performing the IPC.
+     */
+
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
+    NODE_STATE(ksKernelEntry).is_fastpath = true;
+#endif
+
+    /* Dequeue the destination. */
+    endpoint_ptr_set_epQueue_head_np(ep_ptr, TCB_REF(dest->tcbEPNext));
+    if (unlikely(dest->tcbEPNext)) {
+        dest->tcbEPNext->tcbEPPrev = NULL;
+    } else {
+        endpoint_ptr_mset_epQueue_tail_state(ep_ptr, 0, EPState_Idle);
+    }
+
+    badge = cap_endpoint_cap_get_capEPBadge(ep_cap);
+
+#ifdef CONFIG_KERNEL_MCS
+    /* A one-way send never uses the receiver's reply object. */
+    reply_t *reply = thread_state_get_replyObject_np(dest->tcbState);
+    if (reply != NULL) {
+        thread_state_ptr_set_replyObject_np(&dest->tcbState, 0);
+        reply->replyTCB = NULL;
+    }
+#endif
+
+#ifdef CONFIG_FASTPATH_LONG_MESSAGES
+    fastpath_copy_long_mrs(length, NODE_STATE(ksCurThread), dest, sendBuf, recvBuf);
+#else
+    fastpath_copy_mrs(length, NODE_STATE(ksCurThread), dest);
+#endif
+
+    msgInfo = wordFromMessageInfo(seL4_MessageInfo_set_capsUnwrapped(info, 0));
+
+    fastpath_wake(dest, switch_to_dest, cap_pd, stored_hw_asid, badge, msgInfo);
+}
+#endif /* CONFIG_FASTPATH_SEND */
+
+#ifdef CONFIG_FASTPATH_WAIT
+#ifdef CONFIG_ARCH_ARM
+static inline
+#ifndef CONFIG_ARCH_ARM_V6
+FORCE_INLINE
+#endif
+#endif
+void NORETURN fastpath_wait(word_t cptr, word_t msgInfo, syscall_t syscall)
+{
+    cap_t ntfn_cap;
+    notification_t *ntfn_ptr;
+    tcb_t *boundTCB;
+    word_t badge;
+
+    /* Lookup the cap */
+    ntfn_cap = lookup_fp(TCB_PTR_CTE_PTR(NODE_STATE(ksCurThread), tcbCTable)->cap, cptr);
+
+    /* Check it's a notification that can be received on */
+    if (unlikely(!cap_capType_equals(ntfn_cap, cap_notification_cap) ||
+                 !cap_notification_cap_get_capNtfnCanReceive(ntfn_cap))) {
+        slowpath(syscall);
+    }
+
+    /* Get the notification address */
+    ntfn_ptr = NTFN_PTR(cap_notification_cap_get_capNtfnPtr(ntfn_cap));
+
+    /* A notification bound to another thread raises a cap fault */
+    boundTCB = TCB_PTR(notification_ptr_get_ntfnBoundTCB(ntfn_ptr));
+    if (unlikely(boundTCB && boundTCB != NODE_STATE(ksCurThread))) {
+        slowpath(syscall);
+    }
+
+#ifdef CONFIG_KERNEL_MCS
+    /* Receiving a signal can donate or unblock a scheduling context unless
+     * the current thread is running on its own. */
+    if (unlikely(NODE_STATE(ksCurThread)->tcbSchedContext != NODE_STATE(ksCurSC))) {
+        slowpath(syscall);
+    }
+#endif
+
+    if (notification_ptr_get_state(ntfn_ptr) == NtfnState_Active) {
+        /* Collect the accumulated badge and reset the notification. */
+        badge = notification_ptr_get_ntfnMsgIdentifier(ntfn_ptr);
+        notification_ptr_set_state(ntfn_ptr, NtfnState_Idle);
+    } else if (syscall == (syscall_t)SysNBRecv
+#ifdef CONFIG_KERNEL_MCS
+               || syscall == (syscall_t)SysNBWait
+#endif
+              ) {
+        /* Polling a notification with nothing pending returns a zero badge. */
+        badge = 0;
+    } else {
+        /* Blocking is left to the slowpath. */
+        slowpath(syscall);
+    }
+
+#ifdef CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES
+    NODE_STATE(ksKernelEntry).is_fastpath = true;
+#endif
+
+    /* The thread keeps running, and only the badge changes. */
+    fastpath_restore(badge, msgInfo, NODE_STATE(ksCurThread));
+}
+#endif /* CONFIG_FASTPATH_WAIT */
@@ -286,6 +286,16 @@ static seL4_MessageInfo_t transferCaps(seL4_MessageInfo_t info,
 
             cteInsert(dc_ret.cap, slot, destSlot);
 
+#ifdef CONFIG_IPC_PAGE_GRANT
+            /* Map a received frame at the receiver's receive window and
+             * report the window in place of a badge. */
+            if (receiver->tcbReceiveWindow &&
+                Arch_mapReceiveWindow(receiver, destSlot, receiver->tcbReceiveWindow)) {
+                setExtraBadge(receiveBuffer, receiver->tcbReceiveWindow, i);
+                receiver->tcbReceiveWindow = 0;
+            }
+#endif
+
             destSlot = NULL;
         }
     }
@@ -408,6 +418,12 @@ void schedule(void)
         NODE_STATE(ksReprogram) = false;
     }
 #endif
+
+#ifdef CONFIG_UNTYPED_BACKGROUND_RESET
+    if (NODE_STATE(ksCurThread) == NODE_STATE(ksIdleThread)) {
+        untypedBackgroundReset();
+    }
+#endif
 }
 
 void chooseThread(void)
@@ -422,9 +438,9 @@ void chooseThread(void)
         dom = 0;
     }
 
-    if (likely(NODE_STATE(ksReadyQueuesL1Bitmap[dom]))) {
+    if (likely(READY_QUEUES_L1_BITMAP(dom))) {
         prio = getHighestPrio(dom);
-        thread = NODE_STATE(ksReadyQueues)[ready_queues_index(dom, prio)].head;
+        thread = READY_QUEUE(dom, prio).head;
         assert(thread);
         assert(isSchedulable(thread));
 #ifdef CONFIG_KERNEL_MCS
@@ -8,13 +8,37 @@
 #include <model/preemption.h>
 #include <model/statedata.h>
 #include <plat/machine/hardware.h>
+#include <arch/machine.h>
 #include <config.h>
 
+#ifdef CONFIG_PREEMPTION_BUDGET
+/*
+ * Start the time budget of an operation that may be preempted, so that it is
+ * measured from the start of the operation and not from whenever an earlier
+ * one last checked for pending interrupts.
+ */
+void preemptionBudgetStart(void)
+{
+    ksPreemptionCheckTime = readPreemptionCounter();
+}
+#endif
+
 /*
  * Possibly preempt the current thread to allow an interrupt to be handled.
  */
 exception_t preemptionPoint(void)
 {
+#ifdef CONFIG_PREEMPTION_BUDGET
+    /*
+     * The cost of a work unit varies from a single cap deletion to zeroing a
+     * chunk of memory, so bound the time since we last checked for pending
+     * IRQs instead of the number of units.
+     */
+    uint64_t now = readPreemptionCounter();
+
+    if (now - ksPreemptionCheckTime >= CONFIG_PREEMPTION_BUDGET_TICKS) {
+        ksPreemptionCheckTime = now;
+#else
     /* Record that we have performed some work. */
     ksWorkUnitsCompleted++;
 
@@ -28,6 +52,7 @@ exception_t preemptionPoint(void)
      */
     if (ksWorkUnitsCompleted >= CONFIG_MAX_NUM_WORK_UNITS_PER_PREEMPTION) {
         ksWorkUnitsCompleted = 0;
+#endif
 #ifdef CONFIG_KERNEL_MCS
         updateTimestamp();
         if (!(sc_active(NODE_STATE(ksCurSC)) && refill_sufficient(NODE_STATE(ksCurSC), NODE_STATE(ksConsumed)))
@@ -21,9 +21,13 @@ SMP_STATE_DEFINE(smpStatedata_t, ksSMP[CONFIG_MAX_NUM_NODES] ALIGN(L1_CACHE_LINE
 word_t ksNumCPUs;
 
 /* Pointer to the head of the scheduler queue for each priority */
+#ifdef CONFIG_PACKED_READY_QUEUES
+UP_STATE_DEFINE(ready_queues_domain_t, ksReadyQueuesDomains[CONFIG_NUM_DOMAINS]);
+#else
 UP_STATE_DEFINE(tcb_queue_t, ksReadyQueues[NUM_READY_QUEUES]);
 UP_STATE_DEFINE(word_t, ksReadyQueuesL1Bitmap[CONFIG_NUM_DOMAINS]);
 UP_STATE_DEFINE(word_t, ksReadyQueuesL2Bitmap[CONFIG_NUM_DOMAINS][L2_BITMAP_SIZE]);
+#endif
 compile_assert(ksReadyQueuesL1BitmapBigEnough, (L2_BITMAP_SIZE - 1) <= wordBits)
 #ifdef CONFIG_KERNEL_MCS
 /* Head of the queue of threads waiting for their budget to be replenished */
@@ -68,12 +72,26 @@ UP_STATE_DEFINE(timestamp_t, benchmark_end_time);
 UP_STATE_DEFINE(timestamp_t, benchmark_kernel_time);
 UP_STATE_DEFINE(timestamp_t, benchmark_kernel_number_entries);
 UP_STATE_DEFINE(timestamp_t, benchmark_kernel_number_schedules);
+#ifdef CONFIG_BENCHMARK_UTILISATION_PMU
+UP_STATE_DEFINE(uint64_t, benchmark_pmu_start[BENCHMARK_PMU_NUM_EVENTS]);
+#endif
 #endif /* CONFIG_BENCHMARK_TRACK_UTILISATION */
 
 /* Units of work we have completed since the last time we checked for
  * pending interrupts */
 word_t ksWorkUnitsCompleted;
 
+#ifdef CONFIG_PREEMPTION_BUDGET
+/* Value of the preemption counter when we last checked for pending
+ * interrupts */
+uint64_t ksPreemptionCheckTime;
+#endif
+
+#ifdef CONFIG_UNTYPED_BACKGROUND_RESET
+/* Slots of the untypeds queued to be reset while idle, or NULL */
+cte_t *ksUntypedBackgroundReset[CONFIG_UNTYPED_BACKGROUND_RESET_SLOTS];
+#endif
+
 irq_state_t intStateIRQTable[INT_STATE_ARRAY_SIZE];
 /* CNode containing interrupt handler endpoints - like all seL4 objects, this CNode needs to be
  * of a size that is a power of 2 and aligned to its size. */
@@ -105,9 +123,13 @@ char ksIdleThreadSC[CONFIG_MAX_NUM_NODES][BIT(seL4_MinSchedContextBits)] ALIGN(B
 #endif
 
 #if (defined CONFIG_DEBUG_BUILD || defined CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES)
-kernel_entry_t ksKernelEntry;
+UP_STATE_DEFINE(kernel_entry_t, ksKernelEntry);
 #endif /* DEBUG */
 
+#if defined CONFIG_BENCHMARK_TRACK_KERNEL_ENTRIES || defined CONFIG_BENCHMARK_TRACK_UTILISATION
+UP_STATE_DEFINE(timestamp_t, ksEnter);
+#endif
+
 #ifdef CONFIG_KERNEL_LOG_BUFFER
 paddr_t ksUserLogBuffer;
 #endif /* CONFIG_KERNEL_LOG_BUFFER */
@@ -453,6 +453,12 @@ void cteMove(cap_t newCap, cte_t *srcSlot, cte_t *destSlot)
     assert((cte_t *)mdb_node_get_mdbNext(destSlot->cteMDBNode) == NULL &&
            (cte_t *)mdb_node_get_mdbPrev(destSlot->cteMDBNode) == NULL);
 
+#ifdef CONFIG_UNTYPED_BACKGROUND_RESET
+    if (cap_get_capType(newCap) == cap_untyped_cap) {
+        untypedBackgroundResetSwap(srcSlot, destSlot);
+    }
+#endif
+
     mdb = srcSlot->cteMDBNode;
     destSlot->cap = newCap;
     srcSlot->cap = cap_null_cap_new();
@@ -491,6 +497,12 @@ void cteSwap(cap_t cap1, cte_t *slot1, cap_t cap2, cte_t *slot2)
     mdb_node_t mdb1, mdb2;
     word_t next_ptr, prev_ptr;
 
+#ifdef CONFIG_UNTYPED_BACKGROUND_RESET
+    if (cap_get_capType(cap1) == cap_untyped_cap || cap_get_capType(cap2) == cap_untyped_cap) {
+        untypedBackgroundResetSwap(slot1, slot2);
+    }
+#endif
+
     slot1->cap = cap2;
     slot2->cap = cap1;
 
@@ -525,10 +537,31 @@ void cteSwap(cap_t cap1, cte_t *slot1, cap_t cap2, cte_t *slot2)
             CTE_REF(slot1));
 }
 
+#ifdef CONFIG_REVOKE_BATCH
+#define REVOKE_BATCH_SIZE CONFIG_REVOKE_BATCH_SIZE
+#else
+#define REVOKE_BATCH_SIZE 1
+
+static inline void Arch_revokeBatchBegin(void)
+{
+}
+
+static inline void Arch_revokeBatchEnd(void)
+{
+}
+#endif
+
+/* The descendants are deleted in batches of REVOKE_BATCH_SIZE. The
+ * architecture may defer work, such as remote TLB invalidations, to the end
+ * of a batch. Every batch is closed before the preemption point, so nothing
+ * is outstanding when the revoke is preempted, fails or returns. */
 exception_t cteRevoke(cte_t *slot)
 {
     cte_t *nextPtr;
-    exception_t status;
+    exception_t status = EXCEPTION_NONE;
+    word_t batched = 0;
+
+    Arch_revokeBatchBegin();
 
     /* there is no need to check for a NullCap as NullCaps are
        always accompanied by null mdb pointers */
@@ -537,16 +570,26 @@ exception_t cteRevoke(cte_t *slot)
          nextPtr = CTE_PTR(mdb_node_get_mdbNext(slot->cteMDBNode))) {
         status = cteDelete(nextPtr, true);
         if (status != EXCEPTION_NONE) {
-            return status;
+            break;
         }
 
-        status = preemptionPoint();
-        if (status != EXCEPTION_NONE) {
-            return status;
+        batched++;
+        if (batched >= REVOKE_BATCH_SIZE) {
+            Arch_revokeBatchEnd();
+            batched = 0;
+
+            status = preemptionPoint();
+            if (status != EXCEPTION_NONE) {
+                return status;
+            }
+
+            Arch_revokeBatchBegin();
         }
     }
 
-    return EXCEPTION_NONE;
+    Arch_revokeBatchEnd();
+
+    return status;
 }
 
 exception_t cteDelete(cte_t *slot, bool_t exposed)
@@ -584,6 +627,11 @@ static void emptySlot(cte_t *slot, cap_t cleanupInfo)
             mdb_node_ptr_set_mdbFirstBadged(&next->cteMDBNode,
                                             mdb_node_get_mdbFirstBadged(next->cteMDBNode) ||
                                             mdb_node_get_mdbFirstBadged(mdbNode));
+#ifdef CONFIG_UNTYPED_BACKGROUND_RESET
+        if (cap_get_capType(slot->cap) == cap_untyped_cap) {
+            untypedBackgroundResetRemove(slot);
+        }
+#endif
         slot->cap = cap_null_cap_new();
         slot->cteMDBNode = nullMDBNode;
 
@@ -126,6 +126,73 @@ void sendIPC(bool_t blocking, bool_t do_call, word_t badge,
     }
 }
 
+#ifdef CONFIG_BATCHED_IPC
+bool_t sendBatchedIPC(word_t badge, seL4_MessageInfo_t info, word_t *msg, endpoint_t *epptr)
+{
+    tcb_queue_t queue;
+    tcb_t *dest;
+    word_t *receiveBuffer;
+    word_t length, i;
+
+    /* Only a thread that is already waiting can be sent to without blocking. */
+    if (endpoint_ptr_get_state(epptr) != EPState_Recv) {
+        return false;
+    }
+
+    /* Get the head of the endpoint queue. */
+    queue = ep_ptr_get_queue(epptr);
+    dest = queue.head;
+
+    /* Haskell error "Receive endpoint queue must not be empty" */
+    assert(dest);
+
+    /* Dequeue the first TCB */
+    queue = tcbEPDequeue(dest, queue);
+    ep_ptr_set_queue(epptr, queue);
+
+    if (!queue.head) {
+        endpoint_ptr_set_state(epptr, EPState_Idle);
+    }
+
+    /* Do the transfer, as doNormalTransfer does for a message without caps,
+     * but taking the message words from 'msg'. */
+    receiveBuffer = lookupIPCBuffer(true, dest);
+    length = seL4_MessageInfo_get_length(info);
+
+    for (i = 0; i < length && i < n_msgRegisters; i++) {
+        setRegister(dest, msgRegisters[i], msg[i]);
+    }
+    if (receiveBuffer) {
+        for (; i < length; i++) {
+            receiveBuffer[i + 1] = msg[i];
+        }
+    }
+
+    info = seL4_MessageInfo_set_extraCaps(info, 0);
+    info = seL4_MessageInfo_set_capsUnwrapped(info, 0);
+    info = seL4_MessageInfo_set_length(info, i);
+    setRegister(dest, msgInfoRegister, wordFromMessageInfo(info));
+    setRegister(dest, badgeRegister, badge);
+
+#ifdef CONFIG_KERNEL_MCS
+    reply_t *reply = REPLY_PTR(thread_state_get_replyObject(dest->tcbState));
+    if (reply) {
+        reply_unlink(reply, dest);
+    }
+
+    setThreadState(dest, ThreadState_Running);
+    if (sc_sporadic(dest->tcbSchedContext) && dest->tcbSchedContext != NODE_STATE(ksCurSC)) {
+        refill_unblock_check(dest->tcbSchedContext);
+    }
+#else
+    setThreadState(dest, ThreadState_Running);
+#endif
+    possibleSwitchTo(dest);
+
+    return true;
+}
+#endif /* CONFIG_BATCHED_IPC */
+
 #ifdef CONFIG_KERNEL_MCS
 void receiveIPC(tcb_t *thread, cap_t cap, bool_t isBlocking, cap_t replyCap)
 #else
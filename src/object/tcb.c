@@ -57,12 +57,12 @@ static inline void addToBitmap(word_t cpu, word_t dom, word_t prio)
     l1index = prio_to_l1index(prio);
     l1index_inverted = invert_l1index(l1index);
 
-    NODE_STATE_ON_CORE(ksReadyQueuesL1Bitmap[dom], cpu) |= BIT(l1index);
+    READY_QUEUES_L1_BITMAP_ON_CORE(dom, cpu) |= BIT(l1index);
     /* we invert the l1 index when accessed the 2nd level of the bitmap in
        order to increase the liklihood that high prio threads l2 index word will
        be on the same cache line as the l1 index word - this makes sure the
        fastpath is fastest for high prio threads */
-    NODE_STATE_ON_CORE(ksReadyQueuesL2Bitmap[dom][l1index_inverted], cpu) |= BIT(prio & MASK(wordRadix));
+    READY_QUEUES_L2_BITMAP_ON_CORE(dom, l1index_inverted, cpu) |= BIT(prio & MASK(wordRadix));
 }
 
 static inline void removeFromBitmap(word_t cpu, word_t dom, word_t prio)
@@ -72,9 +72,9 @@ static inline void removeFromBitmap(word_t cpu, word_t dom, word_t prio)
 
     l1index = prio_to_l1index(prio);
     l1index_inverted = invert_l1index(l1index);
-    NODE_STATE_ON_CORE(ksReadyQueuesL2Bitmap[dom][l1index_inverted], cpu) &= ~BIT(prio & MASK(wordRadix));
-    if (unlikely(!NODE_STATE_ON_CORE(ksReadyQueuesL2Bitmap[dom][l1index_inverted], cpu))) {
-        NODE_STATE_ON_CORE(ksReadyQueuesL1Bitmap[dom], cpu) &= ~BIT(l1index);
+    READY_QUEUES_L2_BITMAP_ON_CORE(dom, l1index_inverted, cpu) &= ~BIT(prio & MASK(wordRadix));
+    if (unlikely(!READY_QUEUES_L2_BITMAP_ON_CORE(dom, l1index_inverted, cpu))) {
+        READY_QUEUES_L1_BITMAP_ON_CORE(dom, cpu) &= ~BIT(l1index);
     }
 }
 
@@ -90,12 +90,10 @@ void tcbSchedEnqueue(tcb_t *tcb)
         tcb_queue_t queue;
         dom_t dom;
         prio_t prio;
-        word_t idx;
 
         dom = tcb->tcbDomain;
         prio = tcb->tcbPriority;
-        idx = ready_queues_index(dom, prio);
-        queue = NODE_STATE_ON_CORE(ksReadyQueues[idx], tcb->tcbAffinity);
+        queue = READY_QUEUE_ON_CORE(dom, prio, tcb->tcbAffinity);
 
         if (!queue.end) { /* Empty list */
             queue.end = tcb;
@@ -107,7 +105,7 @@ void tcbSchedEnqueue(tcb_t *tcb)
         tcb->tcbSchedNext = queue.head;
         queue.head = tcb;
 
-        NODE_STATE_ON_CORE(ksReadyQueues[idx], tcb->tcbAffinity) = queue;
+        READY_QUEUE_ON_CORE(dom, prio, tcb->tcbAffinity) = queue;
 
         thread_state_ptr_set_tcbQueued(&tcb->tcbState, true);
     }
@@ -125,12 +123,10 @@ void tcbSchedAppend(tcb_t *tcb)
         tcb_queue_t queue;
         dom_t dom;
         prio_t prio;
-        word_t idx;
 
         dom = tcb->tcbDomain;
         prio = tcb->tcbPriority;
-        idx = ready_queues_index(dom, prio);
-        queue = NODE_STATE_ON_CORE(ksReadyQueues[idx], tcb->tcbAffinity);
+        queue = READY_QUEUE_ON_CORE(dom, prio, tcb->tcbAffinity);
 
         if (!queue.head) { /* Empty list */
             queue.head = tcb;
@@ -142,7 +138,7 @@ void tcbSchedAppend(tcb_t *tcb)
         tcb->tcbSchedNext = NULL;
         queue.end = tcb;
 
-        NODE_STATE_ON_CORE(ksReadyQueues[idx], tcb->tcbAffinity) = queue;
+        READY_QUEUE_ON_CORE(dom, prio, tcb->tcbAffinity) = queue;
 
         thread_state_ptr_set_tcbQueued(&tcb->tcbState, true);
     }
@@ -155,12 +151,10 @@ void tcbSchedDequeue(tcb_t *tcb)
         tcb_queue_t queue;
         dom_t dom;
         prio_t prio;
-        word_t idx;
 
         dom = tcb->tcbDomain;
         prio = tcb->tcbPriority;
-        idx = ready_queues_index(dom, prio);
-        queue = NODE_STATE_ON_CORE(ksReadyQueues[idx], tcb->tcbAffinity);
+        queue = READY_QUEUE_ON_CORE(dom, prio, tcb->tcbAffinity);
 
         if (tcb->tcbSchedPrev) {
             tcb->tcbSchedPrev->tcbSchedNext = tcb->tcbSchedNext;
@@ -177,7 +171,7 @@ void tcbSchedDequeue(tcb_t *tcb)
             queue.end = tcb->tcbSchedPrev;
         }
 
-        NODE_STATE_ON_CORE(ksReadyQueues[idx], tcb->tcbAffinity) = queue;
+        READY_QUEUE_ON_CORE(dom, prio, tcb->tcbAffinity) = queue;
 
         thread_state_ptr_set_tcbQueued(&tcb->tcbState, false);
     }
@@ -257,6 +251,145 @@ tcb_queue_t tcbEPDequeue(tcb_t *tcb, tcb_queue_t queue)
 }
 
 #ifdef CONFIG_KERNEL_MCS
+#ifdef CONFIG_RELEASE_QUEUE_HEAP
+/* The release queue is a pairing heap whose root, ksReleaseHead, is the
+ * thread with the earliest release time. */
+static inline bool_t releaseBefore(tcb_t *a, tcb_t *b)
+{
+    return refill_head(a->tcbSchedContext)->rTime < refill_head(b->tcbSchedContext)->rTime;
+}
+
+/* Merge two detached heaps, returning the new root. */
+static tcb_t *releaseHeapMeld(tcb_t *a, tcb_t *b)
+{
+    if (releaseBefore(b, a)) {
+        tcb_t *tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    b->tcbSchedNext = a->tcbReleaseChild;
+    if (a->tcbReleaseChild) {
+        a->tcbReleaseChild->tcbSchedPrev = b;
+    }
+    b->tcbSchedPrev = a;
+    a->tcbReleaseChild = b;
+
+    return a;
+}
+
+/* Merge a list of sibling heaps into one with the usual two pass pairing:
+ * meld neighbouring pairs left to right, then meld the results right to
+ * left. The intermediate results are chained through tcbSchedPrev. */
+static tcb_t *releaseHeapMergePairs(tcb_t *first)
+{
+    tcb_t *pairs = NULL;
+    tcb_t *root;
+
+    while (first) {
+        tcb_t *a = first;
+        tcb_t *b = a->tcbSchedNext;
+
+        a->tcbSchedNext = NULL;
+        a->tcbSchedPrev = NULL;
+        if (b) {
+            first = b->tcbSchedNext;
+            b->tcbSchedNext = NULL;
+            b->tcbSchedPrev = NULL;
+            a = releaseHeapMeld(a, b);
+        } else {
+            first = NULL;
+        }
+        a->tcbSchedPrev = pairs;
+        pairs = a;
+    }
+
+    if (!pairs) {
+        return NULL;
+    }
+
+    root = pairs;
+    pairs = root->tcbSchedPrev;
+    root->tcbSchedPrev = NULL;
+    while (pairs) {
+        tcb_t *next = pairs->tcbSchedPrev;
+        pairs->tcbSchedPrev = NULL;
+        root = releaseHeapMeld(pairs, root);
+        pairs = next;
+    }
+
+    return root;
+}
+
+void tcbReleaseRemove(tcb_t *tcb)
+{
+    if (likely(thread_state_get_tcbInReleaseQueue(tcb->tcbState))) {
+        tcb_t *children = releaseHeapMergePairs(tcb->tcbReleaseChild);
+
+        if (tcb == NODE_STATE_ON_CORE(ksReleaseHead, tcb->tcbAffinity)) {
+            NODE_STATE_ON_CORE(ksReleaseHead, tcb->tcbAffinity) = children;
+            /* the head has changed, we might need to set a new timeout */
+            NODE_STATE_ON_CORE(ksReprogram, tcb->tcbAffinity) = true;
+        } else {
+            /* cut the subtree out of its parent's child list */
+            if (tcb->tcbSchedPrev->tcbReleaseChild == tcb) {
+                tcb->tcbSchedPrev->tcbReleaseChild = tcb->tcbSchedNext;
+            } else {
+                tcb->tcbSchedPrev->tcbSchedNext = tcb->tcbSchedNext;
+            }
+            if (tcb->tcbSchedNext) {
+                tcb->tcbSchedNext->tcbSchedPrev = tcb->tcbSchedPrev;
+            }
+
+            /* the children release no earlier than the root, so the head is unchanged */
+            if (children) {
+                NODE_STATE_ON_CORE(ksReleaseHead, tcb->tcbAffinity) =
+                    releaseHeapMeld(NODE_STATE_ON_CORE(ksReleaseHead, tcb->tcbAffinity), children);
+            }
+        }
+
+        tcb->tcbReleaseChild = NULL;
+        tcb->tcbSchedNext = NULL;
+        tcb->tcbSchedPrev = NULL;
+        thread_state_ptr_set_tcbInReleaseQueue(&tcb->tcbState, false);
+    }
+}
+
+void tcbReleaseEnqueue(tcb_t *tcb)
+{
+    assert(thread_state_get_tcbInReleaseQueue(tcb->tcbState) == false);
+    assert(thread_state_get_tcbQueued(tcb->tcbState) == false);
+
+    tcb_t *head = NODE_STATE_ON_CORE(ksReleaseHead, tcb->tcbAffinity);
+
+    tcb->tcbReleaseChild = NULL;
+    tcb->tcbSchedNext = NULL;
+    tcb->tcbSchedPrev = NULL;
+
+    if (head == NULL || releaseBefore(tcb, head)) {
+        NODE_STATE_ON_CORE(ksReprogram, tcb->tcbAffinity) = true;
+    }
+    NODE_STATE_ON_CORE(ksReleaseHead, tcb->tcbAffinity) = head ? releaseHeapMeld(head, tcb) : tcb;
+
+    thread_state_ptr_set_tcbInReleaseQueue(&tcb->tcbState, true);
+}
+
+tcb_t *tcbReleaseDequeue(void)
+{
+    assert(NODE_STATE(ksReleaseHead) != NULL);
+    assert(NODE_STATE(ksReleaseHead)->tcbSchedPrev == NULL);
+    SMP_COND_STATEMENT(assert(NODE_STATE(ksReleaseHead)->tcbAffinity == getCurrentCPUIndex()));
+
+    tcb_t *detached_head = NODE_STATE(ksReleaseHead);
+    NODE_STATE(ksReleaseHead) = releaseHeapMergePairs(detached_head->tcbReleaseChild);
+    detached_head->tcbReleaseChild = NULL;
+
+    thread_state_ptr_set_tcbInReleaseQueue(&detached_head->tcbState, false);
+    NODE_STATE(ksReprogram) = true;
+
+    return detached_head;
+}
+#else
 void tcbReleaseRemove(tcb_t *tcb)
 {
     if (likely(thread_state_get_tcbInReleaseQueue(tcb->tcbState))) {
@@ -334,6 +467,7 @@ tcb_t *tcbReleaseDequeue(void)
 
     return detached_head;
 }
+#endif /* CONFIG_RELEASE_QUEUE_HEAP */
 #endif
 
 cptr_t PURE getExtraCPtr(word_t *bufferPtr, word_t i)
@@ -429,9 +563,16 @@ word_t copyMRs(tcb_t *sender, word_t *sendBuf, tcb_t *receiver,
     }
 
     /* Copy out-of-line words */
+#ifdef CONFIG_FAST_COPY_MRS
+    if (i < n) {
+        copyWords(&recvBuf[i + 1], &sendBuf[i + 1], n - i);
+        i = n;
+    }
+#else
     for (; i < n; i++) {
         recvBuf[i + 1] = sendBuf[i + 1];
     }
+#endif
 
     return i;
 }
@@ -771,6 +912,37 @@ static exception_t decodeSetTLSBase(cap_t cap, word_t length, word_t *buffer)
     return invokeSetTLSBase(TCB_PTR(cap_thread_cap_get_capTCBPtr(cap)), tls_base);
 }
 
+#ifdef CONFIG_IPC_PAGE_GRANT
+static exception_t invokeSetReceiveWindow(tcb_t *thread, word_t window)
+{
+    thread->tcbReceiveWindow = window;
+
+    return EXCEPTION_NONE;
+}
+
+static exception_t decodeSetReceiveWindow(cap_t cap, word_t length, word_t *buffer)
+{
+    word_t window;
+
+    if (length < 1) {
+        userError("TCB SetReceiveWindow: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    window = getSyscallArg(0, buffer);
+
+    if (!IS_ALIGNED(window, seL4_PageBits)) {
+        userError("TCB SetReceiveWindow: Window is not page aligned.");
+        current_syscall_error.type = seL4_AlignmentError;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return invokeSetReceiveWindow(TCB_PTR(cap_thread_cap_get_capTCBPtr(cap)), window);
+}
+#endif /* CONFIG_IPC_PAGE_GRANT */
+
 /* The following functions sit in the syscall error monad, but include the
  * exception cases for the preemptible bottom end, as they call the invoke
  * functions directly.  This is a significant deviation from the Haskell
@@ -864,6 +1036,11 @@ exception_t decodeTCBInvocation(word_t invLabel, word_t length, cap_t cap,
     case TCBSetTLSBase:
         return decodeSetTLSBase(cap, length, buffer);
 
+#ifdef CONFIG_IPC_PAGE_GRANT
+    case TCBSetReceiveWindow:
+        return decodeSetReceiveWindow(cap, length, buffer);
+#endif
+
     default:
         /* Haskell: "throw IllegalOperation" */
         userError("TCB: Illegal operation.");
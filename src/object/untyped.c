@@ -16,13 +16,276 @@
 #include <object/cnode.h>
 #include <kernel/cspace.h>
 #include <kernel/thread.h>
+#include <model/statedata.h>
+#include <plat/machine/hardware.h>
+#include <smp/lock.h>
 #include <util.h>
 
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+/* Memory being reset is usually not touched again soon, so avoid pulling it
+ * through the cache. */
+#define clearUntypedMemory clearMemoryStreaming
+#else
+#define clearUntypedMemory clearMemory
+#endif
+
 static word_t alignUp(word_t baseValue, word_t alignment)
 {
     return (baseValue + (BIT(alignment) - 1)) & ~MASK(alignment);
 }
 
+#ifdef CONFIG_UNTYPED_RETYPE_BATCH
+/* The per-object checks of Retype, for a descriptor whose type is in message
+ * word typeArg and whose size_bits is in the word after it. */
+static exception_t checkRetypeObject(word_t newType, word_t userObjSize,
+                                     bool_t deviceMemory, word_t typeArg)
+{
+    word_t objectSize;
+
+    if (newType >= seL4_ObjectTypeCount) {
+        userError("Untyped RetypeBatch: Invalid object type.");
+        current_syscall_error.type = seL4_InvalidArgument;
+        current_syscall_error.invalidArgumentNumber = typeArg;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    objectSize = getObjectSize(newType, userObjSize);
+    if (userObjSize >= wordBits || objectSize > seL4_MaxUntypedBits) {
+        userError("Untyped RetypeBatch: Invalid object size.");
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 0;
+        current_syscall_error.rangeErrorMax = seL4_MaxUntypedBits;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if ((newType == seL4_CapTableObject && userObjSize == 0) ||
+        (newType == seL4_UntypedObject && userObjSize < seL4_MinUntypedBits)
+#ifdef CONFIG_KERNEL_MCS
+        || (newType == seL4_SchedContextObject && userObjSize < seL4_MinSchedContextBits)
+#endif
+       ) {
+        userError("Untyped RetypeBatch: Requested object size too small.");
+        current_syscall_error.type = seL4_InvalidArgument;
+        current_syscall_error.invalidArgumentNumber = typeArg + 1;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if ((deviceMemory && !Arch_isFrameType(newType))
+        && newType != seL4_UntypedObject) {
+        userError("Untyped RetypeBatch: Creating kernel objects with device untyped");
+        current_syscall_error.type = seL4_InvalidArgument;
+        current_syscall_error.invalidArgumentNumber = typeArg + 1;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    return EXCEPTION_NONE;
+}
+
+static exception_t decodeUntypedRetypeBatch(word_t length, cte_t *slot,
+                                            cap_t cap, word_t *buffer)
+{
+    untyped_retype_group_t groups[seL4_UntypedRetypeBatchMaxDescs];
+    word_t nodeIndex, nodeDepth, numDescs;
+    word_t nodeSize, regionSize, freeOffset, alignedOffset, objectSize;
+    word_t totalObjects = 0;
+    word_t arg, i, j;
+    lookupSlot_ret_t lu_ret;
+    exception_t status;
+    cap_t nodeCap;
+    cte_t *destCNode;
+    bool_t deviceMemory;
+    bool_t reset;
+
+    if (length < seL4_UntypedRetypeBatch_FirstDescriptor ||
+        current_extra_caps.excaprefs[0] == NULL) {
+        userError("Untyped RetypeBatch: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    nodeIndex = getSyscallArg(0, buffer);
+    nodeDepth = getSyscallArg(1, buffer);
+    numDescs  = getSyscallArg(2, buffer);
+
+    if (numDescs < 1 || numDescs > seL4_UntypedRetypeBatchMaxDescs) {
+        userError("Untyped RetypeBatch: Number of descriptors (%d) too small or large.",
+                  (int)numDescs);
+        current_syscall_error.type = seL4_RangeError;
+        current_syscall_error.rangeErrorMin = 1;
+        current_syscall_error.rangeErrorMax = seL4_UntypedRetypeBatchMaxDescs;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    if (length < seL4_UntypedRetypeBatch_FirstDescriptor +
+        numDescs * seL4_UntypedRetypeBatch_DescriptorWords) {
+        userError("Untyped RetypeBatch: Truncated message.");
+        current_syscall_error.type = seL4_TruncatedMessage;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    /* Lookup the destination CNode shared by all groups. */
+    if (nodeDepth == 0) {
+        nodeCap = current_extra_caps.excaprefs[0]->cap;
+    } else {
+        cap_t rootCap = current_extra_caps.excaprefs[0]->cap;
+        lu_ret = lookupTargetSlot(rootCap, nodeIndex, nodeDepth);
+        if (lu_ret.status != EXCEPTION_NONE) {
+            userError("Untyped RetypeBatch: Invalid destination address.");
+            return lu_ret.status;
+        }
+        nodeCap = lu_ret.slot->cap;
+    }
+
+    if (cap_get_capType(nodeCap) != cap_cnode_cap) {
+        userError("Untyped RetypeBatch: Destination cap invalid or read-only.");
+        current_syscall_error.type = seL4_FailedLookup;
+        current_syscall_error.failedLookupWasSource = 0;
+        current_lookup_fault = lookup_fault_missing_capability_new(nodeDepth);
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+    nodeSize = 1ul << cap_cnode_cap_get_capCNodeRadix(nodeCap);
+    destCNode = CTE_PTR(cap_cnode_cap_get_capCNodePtr(nodeCap));
+
+    /* As for Retype, allocation starts from the beginning of the untyped if it
+     * has no children. The groups are then laid out one after the other, each
+     * aligned to its own object size. Offsets from the base of the untyped are
+     * used throughout, which is equivalent as the base is aligned to the size
+     * of the untyped, and cannot overflow. */
+    status = ensureNoChildren(slot);
+    if (status != EXCEPTION_NONE) {
+        freeOffset = FREE_INDEX_TO_OFFSET(cap_untyped_cap_get_capFreeIndex(cap));
+        reset = false;
+    } else {
+        freeOffset = 0;
+        reset = true;
+    }
+    regionSize = BIT(cap_untyped_cap_get_capBlockSize(cap));
+    deviceMemory = cap_untyped_cap_get_capIsDevice(cap);
+
+    for (i = 0; i < numDescs; i++) {
+        untyped_retype_group_t *group = &groups[i];
+        word_t userObjSize;
+
+        arg = seL4_UntypedRetypeBatch_FirstDescriptor + i * seL4_UntypedRetypeBatch_DescriptorWords;
+        group->newType = getSyscallArg(arg + seL4_UntypedRetypeBatch_Type, buffer);
+        userObjSize = getSyscallArg(arg + seL4_UntypedRetypeBatch_SizeBits, buffer);
+        group->destOffset = getSyscallArg(arg + seL4_UntypedRetypeBatch_NodeOffset, buffer);
+        group->destLength = getSyscallArg(arg + seL4_UntypedRetypeBatch_NumObjects, buffer);
+        group->userSize = userObjSize;
+
+        status = checkRetypeObject(group->newType, userObjSize, deviceMemory,
+                                   arg + seL4_UntypedRetypeBatch_Type);
+        if (status != EXCEPTION_NONE) {
+            return status;
+        }
+        objectSize = getObjectSize(group->newType, userObjSize);
+
+        if (group->destOffset > nodeSize - 1) {
+            userError("Untyped RetypeBatch: Destination node offset #%d too large.",
+                      (int)group->destOffset);
+            current_syscall_error.type = seL4_RangeError;
+            current_syscall_error.rangeErrorMin = 0;
+            current_syscall_error.rangeErrorMax = nodeSize - 1;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+        if (group->destLength < 1 ||
+            group->destLength > CONFIG_RETYPE_FAN_OUT_LIMIT - totalObjects) {
+            userError("Untyped RetypeBatch: Number of requested objects (%d) too small or large.",
+                      (int)group->destLength);
+            current_syscall_error.type = seL4_RangeError;
+            current_syscall_error.rangeErrorMin = 1;
+            current_syscall_error.rangeErrorMax = CONFIG_RETYPE_FAN_OUT_LIMIT - totalObjects;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+        if (group->destLength > nodeSize - group->destOffset) {
+            userError("Untyped RetypeBatch: Requested destination window overruns size of node.");
+            current_syscall_error.type = seL4_RangeError;
+            current_syscall_error.rangeErrorMin = 1;
+            current_syscall_error.rangeErrorMax = nodeSize - group->destOffset;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+        totalObjects += group->destLength;
+
+        /* The slots are only checked to be empty before anything is created,
+         * so no two windows may share a slot. */
+        for (j = 0; j < i; j++) {
+            if (group->destOffset < groups[j].destOffset + groups[j].destLength &&
+                groups[j].destOffset < group->destOffset + group->destLength) {
+                userError("Untyped RetypeBatch: Destination windows %d and %d overlap.",
+                          (int)j, (int)i);
+                current_syscall_error.type = seL4_InvalidArgument;
+                current_syscall_error.invalidArgumentNumber = arg + seL4_UntypedRetypeBatch_NodeOffset;
+                return EXCEPTION_SYSCALL_ERROR;
+            }
+        }
+
+        for (j = group->destOffset; j < group->destOffset + group->destLength; j++) {
+            status = ensureEmptySlot(destCNode + j);
+            if (status != EXCEPTION_NONE) {
+                userError("Untyped RetypeBatch: Slot #%d in destination window non-empty.",
+                          (int)j);
+                return status;
+            }
+        }
+
+        alignedOffset = alignUp(freeOffset, objectSize);
+        if (alignedOffset > regionSize ||
+            ((regionSize - alignedOffset) >> objectSize) < group->destLength) {
+            userError("Untyped RetypeBatch: Insufficient memory for descriptor %d.", (int)i);
+            current_syscall_error.type = seL4_NotEnoughMemory;
+            current_syscall_error.memoryLeft = regionSize - freeOffset;
+            return EXCEPTION_SYSCALL_ERROR;
+        }
+        group->regionOffset = alignedOffset;
+        freeOffset = alignedOffset + (group->destLength << objectSize);
+    }
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return invokeUntyped_RetypeBatch(slot, reset, groups, numDescs,
+                                     destCNode, freeOffset, deviceMemory);
+}
+#endif /* CONFIG_UNTYPED_RETYPE_BATCH */
+
+#ifdef CONFIG_UNTYPED_BACKGROUND_RESET
+static exception_t decodeUntypedBackgroundReset(cte_t *slot, cap_t cap)
+{
+    exception_t status;
+    word_t i;
+    bool_t haveFree = false;
+
+    if (cap_untyped_cap_get_capIsDevice(cap)) {
+        userError("Untyped BackgroundReset: Device untypeds are not cleared.");
+        current_syscall_error.type = seL4_IllegalOperation;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    /* Memory below the free index of an untyped with children may be in use. */
+    status = ensureNoChildren(slot);
+    if (status != EXCEPTION_NONE) {
+        userError("Untyped BackgroundReset: Untyped has children.");
+        return status;
+    }
+
+    for (i = 0; i < CONFIG_UNTYPED_BACKGROUND_RESET_SLOTS; i++) {
+        if (ksUntypedBackgroundReset[i] == slot) {
+            haveFree = true;
+            break;
+        }
+        if (ksUntypedBackgroundReset[i] == NULL) {
+            haveFree = true;
+        }
+    }
+    if (!haveFree) {
+        userError("Untyped BackgroundReset: Too many untypeds queued.");
+        current_syscall_error.type = seL4_IllegalOperation;
+        return EXCEPTION_SYSCALL_ERROR;
+    }
+
+    setThreadState(NODE_STATE(ksCurThread), ThreadState_Restart);
+    return invokeUntyped_BackgroundReset(slot);
+}
+#endif /* CONFIG_UNTYPED_BACKGROUND_RESET */
+
 exception_t decodeUntypedInvocation(word_t invLabel, word_t length, cte_t *slot,
                                     cap_t cap, bool_t call, word_t *buffer)
 {
@@ -40,6 +303,18 @@ exception_t decodeUntypedInvocation(word_t invLabel, word_t length, cte_t *slot,
     bool_t deviceMemory;
     bool_t reset;
 
+#ifdef CONFIG_UNTYPED_RETYPE_BATCH
+    if (invLabel == UntypedRetypeBatch) {
+        return decodeUntypedRetypeBatch(length, slot, cap, buffer);
+    }
+#endif
+
+#ifdef CONFIG_UNTYPED_BACKGROUND_RESET
+    if (invLabel == UntypedBackgroundReset) {
+        return decodeUntypedBackgroundReset(slot, cap);
+    }
+#endif
+
     /* Ensure operation is valid. */
     if (invLabel != UntypedRetype) {
         userError("Untyped cap: Illegal operation attempted.");
@@ -253,20 +528,27 @@ static exception_t resetUntypedCap(cte_t *srcSlot)
 
     if (deviceMemory || block_size < chunk) {
         if (! deviceMemory) {
-            clearMemory(regionBase, block_size);
+            clearUntypedMemory(regionBase, block_size);
         }
         srcSlot->cap = cap_untyped_cap_set_capFreeIndex(prev_cap, 0);
     } else {
         for (offset = ROUND_DOWN(offset - 1, chunk);
              offset != - BIT(chunk); offset -= BIT(chunk)) {
-            clearMemory(GET_OFFSET_FREE_PTR(regionBase, offset), chunk);
+            clearUntypedMemory(GET_OFFSET_FREE_PTR(regionBase, offset), chunk);
             srcSlot->cap = cap_untyped_cap_set_capFreeIndex(prev_cap, OFFSET_TO_FREE_INDEX(offset));
             status = preemptionPoint();
             if (status != EXCEPTION_NONE) {
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+                clearMemoryStreamingFence();
+#endif
                 return status;
             }
         }
     }
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+    /* One fence for the whole reset, not one per chunk */
+    clearMemoryStreamingFence();
+#endif
     return EXCEPTION_NONE;
 }
 
@@ -281,6 +563,12 @@ exception_t invokeUntyped_Retype(cte_t *srcSlot,
     void *regionBase = WORD_PTR(cap_untyped_cap_get_capPtr(srcSlot->cap));
     exception_t status;
 
+#ifdef CONFIG_SMP_LAZY_TLB_SHOOTDOWN
+    /* The memory may have been unmapped from a vspace that another core has
+     * not flushed from its TLB yet */
+    doRemoteCallBatchWait();
+#endif
+
     if (reset) {
         status = resetUntypedCap(srcSlot);
         if (status != EXCEPTION_NONE) {
@@ -304,3 +592,159 @@ exception_t invokeUntyped_Retype(cte_t *srcSlot,
 
     return EXCEPTION_NONE;
 }
+
+#ifdef CONFIG_UNTYPED_RETYPE_BATCH
+exception_t invokeUntyped_RetypeBatch(cte_t *srcSlot, bool_t reset,
+                                      untyped_retype_group_t *groups, word_t numGroups,
+                                      cte_t *destCNode, word_t freeOffset,
+                                      bool_t deviceMemory)
+{
+    void *regionBase = WORD_PTR(cap_untyped_cap_get_capPtr(srcSlot->cap));
+    exception_t status;
+    word_t i;
+
+#ifdef CONFIG_SMP_LAZY_TLB_SHOOTDOWN
+    /* The memory may have been unmapped from a vspace that another core has
+     * not flushed from its TLB yet */
+    doRemoteCallBatchWait();
+#endif
+
+    /* The untyped is cleared once for all groups. If this is preempted the
+     * invocation is restarted and decoded again against the new free index. */
+    if (reset) {
+        status = resetUntypedCap(srcSlot);
+        if (status != EXCEPTION_NONE) {
+            return status;
+        }
+    }
+
+    srcSlot->cap = cap_untyped_cap_set_capFreeIndex(srcSlot->cap,
+                                                    OFFSET_TO_FREE_INDEX(freeOffset));
+
+    for (i = 0; i < numGroups; i++) {
+        createNewObjects(groups[i].newType, srcSlot, destCNode,
+                         groups[i].destOffset, groups[i].destLength,
+                         GET_OFFSET_FREE_PTR(regionBase, groups[i].regionOffset),
+                         groups[i].userSize, deviceMemory);
+    }
+
+    return EXCEPTION_NONE;
+}
+#endif /* CONFIG_UNTYPED_RETYPE_BATCH */
+
+#ifdef CONFIG_UNTYPED_BACKGROUND_RESET
+exception_t invokeUntyped_BackgroundReset(cte_t *srcSlot)
+{
+    word_t i;
+    cte_t **entry = NULL;
+
+    if (cap_untyped_cap_get_capFreeIndex(srcSlot->cap) == 0) {
+        return EXCEPTION_NONE;
+    }
+
+    for (i = 0; i < CONFIG_UNTYPED_BACKGROUND_RESET_SLOTS; i++) {
+        if (ksUntypedBackgroundReset[i] == srcSlot) {
+            return EXCEPTION_NONE;
+        }
+        if (ksUntypedBackgroundReset[i] == NULL && entry == NULL) {
+            entry = &ksUntypedBackgroundReset[i];
+        }
+    }
+    assert(entry != NULL);
+    *entry = srcSlot;
+
+    return EXCEPTION_NONE;
+}
+
+/* Called with the kernel lock held when a kernel entry is about to return to
+ * the idle thread. Each queued untyped is zeroed downwards from its free index
+ * in the same chunks as resetUntypedCap, so a Retype or a later idle entry can
+ * take over at any point. */
+void untypedBackgroundReset(void)
+{
+    word_t i, chunks = 0;
+#ifdef CONFIG_SMP_LAZY_TLB_SHOOTDOWN
+    bool_t waited = false;
+#endif
+
+#ifdef CONFIG_SMP_CORE_LOCAL_ENTRIES
+    if (!kernel_lock_is_self_in_queue()) {
+        return;
+    }
+#endif
+
+    for (i = 0; i < CONFIG_UNTYPED_BACKGROUND_RESET_SLOTS; i++) {
+        cte_t *slot = ksUntypedBackgroundReset[i];
+        cte_t *next;
+        cap_t cap;
+        void *regionBase;
+        word_t chunk, offset;
+
+        if (slot == NULL) {
+            continue;
+        }
+
+        /* Stop once the untyped has been retyped again. */
+        cap = slot->cap;
+        next = CTE_PTR(mdb_node_get_mdbNext(slot->cteMDBNode));
+        if (next != NULL && isMDBParentOf(slot, next)) {
+            ksUntypedBackgroundReset[i] = NULL;
+            continue;
+        }
+
+        regionBase = WORD_PTR(cap_untyped_cap_get_capPtr(cap));
+        chunk = MIN(CONFIG_RESET_CHUNK_BITS, cap_untyped_cap_get_capBlockSize(cap));
+        offset = FREE_INDEX_TO_OFFSET(cap_untyped_cap_get_capFreeIndex(cap));
+        while (offset != 0) {
+            if (chunks == CONFIG_UNTYPED_BACKGROUND_RESET_CHUNKS || isIRQPending()) {
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+                clearMemoryStreamingFence();
+#endif
+                return;
+            }
+#ifdef CONFIG_SMP_LAZY_TLB_SHOOTDOWN
+            /* As in invokeUntyped_Retype, another core may still reach this
+             * memory through a stale translation. */
+            if (!waited) {
+                doRemoteCallBatchWait();
+                waited = true;
+            }
+#endif
+            offset = ROUND_DOWN(offset - 1, chunk);
+            clearUntypedMemory(GET_OFFSET_FREE_PTR(regionBase, offset), chunk);
+            slot->cap = cap_untyped_cap_set_capFreeIndex(slot->cap, OFFSET_TO_FREE_INDEX(offset));
+            chunks++;
+        }
+        ksUntypedBackgroundReset[i] = NULL;
+    }
+#ifdef CONFIG_CLEAR_MEMORY_STREAMING
+    clearMemoryStreamingFence();
+#endif
+}
+
+/* The queue refers to slots, so it follows untyped caps as they are moved
+ * or swapped, and forgets them when they are deleted. */
+void untypedBackgroundResetSwap(cte_t *slot1, cte_t *slot2)
+{
+    word_t i;
+
+    for (i = 0; i < CONFIG_UNTYPED_BACKGROUND_RESET_SLOTS; i++) {
+        if (ksUntypedBackgroundReset[i] == slot1) {
+            ksUntypedBackgroundReset[i] = slot2;
+        } else if (ksUntypedBackgroundReset[i] == slot2) {
+            ksUntypedBackgroundReset[i] = slot1;
+        }
+    }
+}
+
+void untypedBackgroundResetRemove(cte_t *slot)
+{
+    word_t i;
+
+    for (i = 0; i < CONFIG_UNTYPED_BACKGROUND_RESET_SLOTS; i++) {
+        if (ksUntypedBackgroundReset[i] == slot) {
+            ksUntypedBackgroundReset[i] = NULL;
+        }
+    }
+}
+#endif /* CONFIG_UNTYPED_BACKGROUND_RESET */
@@ -19,7 +19,7 @@
  * or this call will idle forever */
 void ipiStallCoreCallback(bool_t irqPath)
 {
-    if (clh_is_self_in_queue() && !irqPath) {
+    if (kernel_lock_is_self_in_queue() && !irqPath) {
         /* The current thread is running as we would replace this thread with an idle thread
          *
          * The instruction should be re-executed if we are in kernel to handle syscalls.
@@ -42,8 +42,8 @@ void ipiStallCoreCallback(bool_t irqPath)
         ipi_wait(totalCoreBarrier);
 
         /* Continue waiting on lock */
-        while (big_kernel_lock.node_owners[getCurrentCPUIndex()].next->value != CLHState_Granted) {
-            if (clh_is_ipi_pending(getCurrentCPUIndex())) {
+        while (!kernel_lock_is_granted(getCurrentCPUIndex())) {
+            if (kernel_lock_is_ipi_pending(getCurrentCPUIndex())) {
 
                 /* Multiple calls for similar reason could result in stack overflow */
                 assert((IpiRemoteCall_t)remoteCall != IpiRemoteCall_Stall);
@@ -52,6 +52,10 @@ void ipiStallCoreCallback(bool_t irqPath)
             arch_pause();
         }
 
+#ifdef CONFIG_SMP_CORE_LOCAL_ENTRIES
+        kernel_lock_wait_core_local_entries(getCurrentCPUIndex());
+#endif
+
         /* make sure no resource access passes from this point */
         asm volatile("" ::: "memory");
 
@@ -61,7 +65,7 @@ void ipiStallCoreCallback(bool_t irqPath)
     } else {
         /* We get here either without grabbing the lock from normal interrupt path or from
          * inside the lock while waiting to grab the lock for handling pending interrupt.
-         * In latter case, we return to the 'clh_lock_acquire' to grab the lock and
+         * In latter case, we return to the 'kernel_lock_acquire' to grab the lock and
          * handle the pending interrupt. Its valid as interrups are async events! */
         SCHED_ENQUEUE_CURRENT_TCB;
         switchToIdleThread();
@@ -101,6 +105,121 @@ void doRemoteMaskOp(IpiRemoteCall_t func, word_t data1, word_t data2, word_t dat
     }
 }
 
+#ifdef CONFIG_SMP_BATCHED_REMOTE_CALLS
+remote_call_batch_t remoteCallBatch[CONFIG_MAX_NUM_NODES];
+word_t remoteCallBatchMask;
+word_t remoteCallIPIsSaved;
+
+static bool_t isRemoteCallQueued(remote_call_batch_t *batch, IpiRemoteCall_t func,
+                                 word_t data1, word_t data2, word_t data3)
+{
+    /* Only calls that have not been sent yet are checked. A call that has been
+     * sent may already be running, before the change that queued this one. */
+    for (word_t i = batch->head; i != batch->queued; i++) {
+        remote_call_t *call = &batch->calls[i % MAX_BATCHED_REMOTE_CALLS];
+        if (call->func == func && call->args[0] == data1 && call->args[1] == data2 && call->args[2] == data3) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Make the queued calls of the cores in mask visible to them */
+static void publishRemoteCallBatch(word_t mask)
+{
+    remoteCallBatchMask &= ~mask;
+
+    while (mask) {
+        word_t index = wordBits - 1 - clzl(mask);
+        __atomic_store_n(&remoteCallBatch[index].head, remoteCallBatch[index].queued, __ATOMIC_RELEASE);
+        mask &= ~BIT(index);
+    }
+}
+
+static void sendRemoteCallBatch(word_t mask, bool_t isBlocking)
+{
+    publishRemoteCallBatch(mask);
+
+    if (mask != 0) {
+        /* one IPI per core is sent for the whole batch */
+        remoteCallIPIsSaved -= popcountl(mask);
+        if (isBlocking) {
+            doRemoteMaskOp(IpiRemoteCall_Batch, 0, 0, 0, mask);
+        } else {
+            ipi_send_mask(CORE_IRQ_TO_IRQT(0, irq_remote_call_ipi), mask, false);
+        }
+    }
+}
+
+void doRemoteMaskOpBatched(IpiRemoteCall_t func, word_t data1, word_t data2, word_t data3, word_t mask)
+{
+    /* make sure the current core is not set in the mask */
+    mask &= ~BIT(getCurrentCPUIndex());
+
+    while (mask) {
+        word_t index = wordBits - 1 - clzl(mask);
+        remote_call_batch_t *batch = &remoteCallBatch[index];
+        mask &= ~BIT(index);
+
+        if (!isRemoteCallQueued(batch, func, data1, data2, data3)) {
+            if (batch->queued - __atomic_load_n(&batch->tail, __ATOMIC_ACQUIRE) == MAX_BATCHED_REMOTE_CALLS) {
+                /* the ring is full, have the core catch up first */
+                sendRemoteCallBatch(BIT(index), true);
+            }
+            remote_call_t *call = &batch->calls[batch->queued % MAX_BATCHED_REMOTE_CALLS];
+            call->func = func;
+            call->args[0] = data1;
+            call->args[1] = data2;
+            call->args[2] = data3;
+            batch->queued++;
+            remoteCallBatchMask |= BIT(index);
+        }
+        /* without batching, this call would have been its own IPI */
+        remoteCallIPIsSaved++;
+    }
+}
+
+void doRemoteCallBatchFlush(void)
+{
+    sendRemoteCallBatch(remoteCallBatchMask, !config_set(CONFIG_SMP_LAZY_TLB_SHOOTDOWN));
+}
+
+void handleRemoteCallBatch(bool_t irqPath)
+{
+    remote_call_batch_t *batch = &remoteCallBatch[getCurrentCPUIndex()];
+    word_t head = __atomic_load_n(&batch->head, __ATOMIC_ACQUIRE);
+
+    for (word_t i = batch->tail; i != head; i++) {
+        remote_call_t *call = &batch->calls[i % MAX_BATCHED_REMOTE_CALLS];
+        handleRemoteCallOp(call->func, call->args[0], call->args[1], call->args[2], irqPath);
+    }
+
+    __atomic_store_n(&batch->tail, head, __ATOMIC_RELEASE);
+}
+
+#ifdef CONFIG_SMP_LAZY_TLB_SHOOTDOWN
+void doRemoteCallBatchWait(void)
+{
+    word_t mask = 0;
+
+    /* calls that are still being collected are sent with the wait */
+    publishRemoteCallBatch(remoteCallBatchMask);
+
+    for (word_t i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
+        if (__atomic_load_n(&remoteCallBatch[i].tail, __ATOMIC_ACQUIRE) != remoteCallBatch[i].head) {
+            mask |= BIT(i);
+        }
+    }
+
+    /* the cores that have not caught up yet do so in a synchronous remote call */
+    if (mask != 0) {
+        remoteCallIPIsSaved -= popcountl(mask);
+        doRemoteMaskOp(IpiRemoteCall_Batch, 0, 0, 0, mask);
+    }
+}
+#endif /* CONFIG_SMP_LAZY_TLB_SHOOTDOWN */
+#endif /* CONFIG_SMP_BATCHED_REMOTE_CALLS */
+
 void doMaskReschedule(word_t mask)
 {
     /* make sure the current core is not set in the mask */
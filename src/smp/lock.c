@@ -9,10 +9,16 @@
 
 #ifdef ENABLE_SMP_SUPPORT
 
-clh_lock_t big_kernel_lock ALIGN(L1_CACHE_LINE_SIZE);
+kernel_lock_t big_kernel_lock ALIGN(L1_CACHE_LINE_SIZE);
 
-BOOT_CODE void clh_lock_init(void)
+#ifdef CONFIG_SMP_CORE_LOCAL_ENTRIES
+core_local_entry_t core_local_entries[CONFIG_MAX_NUM_NODES] ALIGN(L1_CACHE_LINE_SIZE);
+core_local_ep_lock_t core_local_ep_locks[CORE_LOCAL_EP_LOCKS] ALIGN(L1_CACHE_LINE_SIZE);
+#endif
+
+BOOT_CODE void kernel_lock_init(void)
 {
+#ifdef CONFIG_SMP_LOCK_CLH
     for (int i = 0; i < CONFIG_MAX_NUM_NODES; i++) {
         big_kernel_lock.node_owners[i].node = &big_kernel_lock.nodes[i];
     }
@@ -20,6 +26,8 @@ BOOT_CODE void clh_lock_init(void)
     /* Initialize the CLH head */
     big_kernel_lock.nodes[CONFIG_MAX_NUM_NODES].value = CLHState_Granted;
     big_kernel_lock.head = &big_kernel_lock.nodes[CONFIG_MAX_NUM_NODES];
+#endif
+    /* The other backends start out unlocked with all of their state zeroed */
 }
 
 #endif /* ENABLE_SMP_SUPPORT */